@@ -0,0 +1,110 @@
+// Varredura completa dos containers sem alocações no heap (user-030).
+//
+// Substitui o operator new global para contar as alocações feitas enquanto
+// cada um dos cinco containers é percorrido (percorrer) lendo todos os campos
+// pelos getters por referência. Cada container recebe a quantidade pedida de
+// registros, exceto o de quartos, limitado a 999 pela chave (Numero); os
+// gerentes usam o custo mínimo de derivação de senha, para que a carga não
+// seja dominada pelo hash. Termina com código 1 se alguma varredura alocar.
+//
+// Uso: bench_alocacoes [quantidade de registros por container]
+
+#include "containers.hpp"
+#include "medicao.hpp"
+#include <atomic>
+#include <new>
+
+using namespace std;
+
+namespace {
+
+atomic<size_t> alocacoes{0};
+
+} // namespace
+
+void* operator new(size_t tamanho) {
+    alocacoes.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(tamanho ? tamanho : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+namespace {
+
+// Executa a varredura e informa as alocações e o tempo por registro
+template <typename Varredura>
+bool medir(const char* nome, size_t registros, Varredura varredura) {
+    size_t soma = 0;
+    const size_t antes = alocacoes.load();
+    Cronometro cronometro;
+    varredura(soma);
+    const double segundos = cronometro.segundos();
+    const size_t feitas = alocacoes.load() - antes;
+    printf("%-10s %8zu registros  %6.1f ns/registro  %zu alocacoes  (soma %zu)\n",
+           nome, registros, segundos * 1e9 / registros, feitas, soma);
+    return feitas == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t quantidade = argumento(argc, argv, 1, 100000);
+    const int quantidadeQuartos = static_cast<int>(min<size_t>(quantidade, 999));
+
+    ContainerGerente gerentes(1, 1);
+    ContainerHospede hospedes;
+    ContainerHotel hoteis;
+    ContainerQuarto quartos;
+    ContainerReserva reservas;
+    const Codigo hotel = gerarCodigo('H', 1);
+    for (size_t i = 0; i < quantidade; i++) {
+        gerentes.incluir(gerarGerente(i));
+        hospedes.incluir(gerarHospede(i));
+        hoteis.incluir(gerarHotel(i));
+        const int quarto = 1 + static_cast<int>(i % quantidadeQuartos);
+        reservas.incluir(gerarReserva(i, quarto, static_cast<int>(i / quantidadeQuartos) * 3, 2));
+    }
+    for (int numero = 1; numero <= quantidadeQuartos; numero++) quartos.incluir(gerarQuarto(numero, hotel));
+
+    bool ok = true;
+    ok &= medir("Gerente", quantidade, [&](size_t& soma) {
+        gerentes.percorrer([&](const Gerente& g) {
+            soma += g.getEmail().getParteLocal().size() + g.getEmail().getDominio().size() +
+                    g.getNome().getValor().size() + g.getSenha().getValor().size() + g.getRamal().getValor();
+        });
+    });
+    ok &= medir("Hospede", quantidade, [&](size_t& soma) {
+        hospedes.percorrer([&](const Hospede& h) {
+            soma += h.getEmail().getParteLocal().size() + h.getEmail().getDominio().size() +
+                    h.getNome().getValor().size() + h.getEndereco().getValor().size() +
+                    h.getCartao().getValor().size();
+        });
+    });
+    ok &= medir("Hotel", quantidade, [&](size_t& soma) {
+        hoteis.percorrer([&](const Hotel& h) {
+            soma += h.getNome().getValor().size() + h.getEndereco().getValor().size() +
+                    h.getTelefone().getValor().size() + h.getCodigo().getValor().size();
+        });
+    });
+    ok &= medir("Quarto", static_cast<size_t>(quantidadeQuartos), [&](size_t& soma) {
+        quartos.percorrer([&](const Quarto& q) {
+            soma += q.getNumero().getValor() + q.getCapacidade().getValor() +
+                    static_cast<size_t>(q.getDiaria().getCentavos()) + q.getHotel().getValor().size();
+        });
+    });
+    ok &= medir("Reserva", quantidade, [&](size_t& soma) {
+        reservas.percorrer([&](const Reserva& r) {
+            soma += r.getCodigo().getValor().size() + r.getChegada().getMes().size() +
+                    r.getPartida().getDia() + static_cast<size_t>(r.getValor().getCentavos()) +
+                    r.getQuarto().getValor();
+        });
+    });
+
+    if (!ok) {
+        printf("FALHA: alguma varredura alocou memoria.\n");
+        return 1;
+    }
+    return 0;
+}
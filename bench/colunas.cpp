@@ -0,0 +1,93 @@
+// Consultas analíticas por linhas e pelo espelho colunar (user-035).
+//
+// Compara duas consultas feitas percorrendo os objetos completos da lista e
+// pelos núcleos do espelho colunar: a soma da receita das reservas com chegada
+// em um intervalo e a contagem de quartos com capacidade mínima. Termina com
+// código 1 se os dois caminhos discordarem.
+//
+// Uso: bench_colunas [quantidade de reservas] [repetições]
+
+#include "containers.hpp"
+#include "medicao.hpp"
+
+using namespace std;
+
+namespace {
+
+// Repete a consulta e informa o melhor tempo por registro
+template <typename Consulta>
+long long medir(const char* nome, size_t registros, size_t repeticoes, Consulta consulta) {
+    long long resultado = 0;
+    double melhor = 1e30;
+    for (size_t i = 0; i < repeticoes; i++) {
+        Cronometro cronometro;
+        resultado = consulta();
+        melhor = min(melhor, cronometro.segundos());
+    }
+    printf("%-24s %8zu registros  %7.2f ns/registro  (resultado %lld)\n",
+           nome, registros, melhor * 1e9 / registros, resultado);
+    return resultado;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t quantidade = argumento(argc, argv, 1, 1000000);
+    const size_t repeticoes = argumento(argc, argv, 2, 10);
+
+    ContainerQuarto quartos;
+    ContainerReserva reservas;
+    quartos.habilitarColunas();
+    reservas.habilitarColunas();
+    const Codigo hotel = gerarCodigo('H', 1);
+    for (int numero = 1; numero <= 999; numero++) {
+        quartos.incluir(gerarQuarto(numero, hotel, 10000 + numero * 100));
+    }
+    for (size_t i = 0; i < quantidade; i++) {
+        Reserva reserva = gerarReserva(i, 1 + static_cast<int>(i % 999), static_cast<int>(i / 999) * 3, 2);
+        Dinheiro valor;
+        valor.setCentavos(10000 + static_cast<long long>(i % 5000));
+        reserva.setValor(valor);
+        reservas.incluir(reserva);
+    }
+
+    // Chegadas na primeira metade do período gerado
+    const int inicio = gerarData(0).getSerial();
+    const int fim = inicio + static_cast<int>(quantidade / 999) * 3 / 2 + 1;
+    const unsigned short minima = 3;
+
+    long long linhas = medir("Receita (linhas)", quantidade, repeticoes, [&] {
+        long long total = 0;
+        reservas.percorrer([&](const Reserva& r) {
+            const int chegada = r.getChegada().getSerial();
+            if (chegada >= inicio && chegada < fim) total += r.getValor().getCentavos();
+        });
+        return total;
+    });
+    long long colunas = medir("Receita (colunas)", quantidade, repeticoes, [&] {
+        long long total = 0;
+        reservas.lerColunas([&](const ColunasReserva* c) { total = c->somarValores(inicio, fim); });
+        return total;
+    });
+    bool ok = linhas == colunas;
+
+    linhas = medir("Capacidade (linhas)", 999, repeticoes, [&] {
+        long long total = 0;
+        quartos.percorrer([&](const Quarto& q) { total += q.getCapacidade().getValor() >= minima; });
+        return total;
+    });
+    colunas = medir("Capacidade (colunas)", 999, repeticoes, [&] {
+        long long total = 0;
+        quartos.lerColunas([&](const ColunasQuarto* c) {
+            total = static_cast<long long>(c->contarPorCapacidade(minima));
+        });
+        return total;
+    });
+    ok &= linhas == colunas;
+
+    if (!ok) {
+        printf("FALHA: linhas e colunas divergem.\n");
+        return 1;
+    }
+    return 0;
+}
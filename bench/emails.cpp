@@ -0,0 +1,146 @@
+// Memória e custo de hash dos EMAIL com domínio internado (user-027).
+//
+// Pegada: monta hóspedes em uma lista com emails hospede.NNNNNNN@<um de 6
+// domínios>, primeiro como valores de passagem (cada EMAIL guarda o texto
+// "local@domínio" inteiro, como antes do internamento) e depois internados, e
+// informa o heap vivo por hóspede (mallinfo2, da glibc). Por fim, inclui os
+// mesmos hóspedes no ContainerHospede, com os índices dele.
+//
+// Hash: mede hash<EMAIL> nas duas formas e a vazão de pesquisas em um
+// unordered_set<EMAIL> com 1, 2, 4... threads; com o domínio internado, o hash
+// lê o resumo pronto na TabelaDominios, sem trava.
+//
+// Termina com código 1 se o internamento não reduzir o heap ou se alguma
+// pesquisa não encontrar o email.
+//
+// Uso: bench_emails [hóspedes] [threads]
+
+#include "containers.hpp"
+#include "medicao.hpp"
+#include <atomic>
+#include <list>
+#include <thread>
+#include <unordered_set>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char* const DOMINIOS[] = {"gmail.com", "hotmail.com", "outlook.com", "yahoo.com.br", "uol.com.br", "unb.br"};
+
+// Bytes em uso no heap; 0 se a biblioteca não informar
+size_t heapVivo() {
+#if defined(__GLIBC__)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+Hospede gerarComEmail(size_t i, bool internar) {
+    // Objeto novo: sobre o email de gerarHospede, o texto curto herdaria o buffer dele
+    const Hospede modelo = gerarHospede(i);
+    Hospede hospede;
+    char texto[64];
+    snprintf(texto, sizeof(texto), "hospede.%07zu@%s", i % 10000000, DOMINIOS[i % 6]);
+    EMAIL email;
+    email.setValor(texto);
+    hospede.setEmail(std::move(email));
+    hospede.setNome(modelo.getNome());
+    hospede.setEndereco(modelo.getEndereco());
+    hospede.setCartao(modelo.getCartao());
+    if (internar) hospede.internarEmail(); // Como os containers fazem ao armazenar
+    return hospede;
+}
+
+// Heap vivo por hóspede depois de montar a lista
+double montar(list<Hospede>& hospedes, size_t quantidade, bool internar) {
+    const size_t antes = heapVivo();
+    for (size_t i = 0; i < quantidade; i++) hospedes.push_back(gerarComEmail(i, internar));
+    return static_cast<double>(heapVivo() - antes) / quantidade;
+}
+
+// Nanossegundos por hash<EMAIL>
+double medirHash(const list<Hospede>& hospedes) {
+    size_t soma = 0;
+    Cronometro cronometro;
+    for (const auto& h : hospedes) soma += hash<EMAIL>()(h.getEmail());
+    const double ns = cronometro.segundos() * 1e9 / hospedes.size();
+    if (soma == 42) printf(" "); // Impede que o laço seja descartado
+    return ns;
+}
+
+// Pesquisas por segundo no conjunto; falhas conta os emails não encontrados
+double medirPesquisas(const vector<EMAIL>& emails, size_t threads, atomic<size_t>& falhas) {
+    const unordered_set<EMAIL> conjunto(emails.begin(), emails.end());
+    Cronometro cronometro;
+    vector<thread> trabalhadores;
+    for (size_t t = 0; t < threads; t++) {
+        trabalhadores.emplace_back([&, t] {
+            for (size_t i = t; i < emails.size(); i += threads) {
+                if (conjunto.find(emails[i]) == conjunto.end()) falhas.fetch_add(1, memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& t : trabalhadores) t.join();
+    return emails.size() / cronometro.segundos();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t quantidade = argumento(argc, argv, 1, 1000000);
+    const size_t threads = argumento(argc, argv, 2, 4);
+    printf("sizeof(EMAIL) = %zu, sizeof(Hospede) = %zu\n", sizeof(EMAIL), sizeof(Hospede));
+
+    // 1. Antes de qualquer internamento: os domínios ficam no texto de cada EMAIL
+    double porHospedeTexto;
+    double hashTexto;
+    {
+        list<Hospede> hospedes;
+        porHospedeTexto = montar(hospedes, quantidade, false);
+        hashTexto = medirHash(hospedes);
+    }
+
+    // 2. Domínios internados
+    list<Hospede> hospedes;
+    const double porHospedeInternado = montar(hospedes, quantidade, true);
+    const double hashInternado = medirHash(hospedes);
+
+    printf("Lista, dominio em texto:   %7.1f B/hospede no heap (%.1f MB), hash %5.1f ns\n",
+           porHospedeTexto, porHospedeTexto * quantidade / 1e6, hashTexto);
+    printf("Lista, dominio internado:  %7.1f B/hospede no heap (%.1f MB), hash %5.1f ns\n",
+           porHospedeInternado, porHospedeInternado * quantidade / 1e6, hashInternado);
+
+    // 3. O mesmo conteúdo no container, com índice de emails e de nomes
+    {
+        const size_t antes = heapVivo();
+        ContainerHospede container;
+        for (const auto& h : hospedes) container.incluir(h);
+        printf("ContainerHospede:          %7.1f B/hospede no heap, com os indices\n",
+               static_cast<double>(heapVivo() - antes) / quantidade);
+    }
+
+    // 4. Pesquisas concorrentes por emails internados
+    vector<EMAIL> emails;
+    emails.reserve(quantidade);
+    for (const auto& h : hospedes) emails.push_back(h.getEmail());
+    atomic<size_t> falhas{0};
+    printf("Nucleos disponiveis: %u\n", thread::hardware_concurrency());
+    for (size_t n = 1; n <= threads; n *= 2) {
+        printf("%2zu threads: %10.0f pesquisas/s\n", n, medirPesquisas(emails, n, falhas));
+    }
+
+    if (heapVivo() != 0 && porHospedeInternado >= porHospedeTexto) {
+        printf("FALHA: o internamento nao reduziu o heap por hospede.\n");
+        return 1;
+    }
+    if (falhas.load() > 0) {
+        printf("FALHA: %zu pesquisas nao encontraram o email.\n", falhas.load());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+// Vazão e latência de cauda do Escalonador sob a carga dos serviços (user-041).
+//
+// Clientes em laço fechado submetem, pelo CntrMSReservaAssincrono, leituras
+// (lerQuarto, cotarReserva) misturadas a escritas (criarReserva) e medem o
+// tempo até cada futuro ficar pronto, para 1 e 4 trabalhadores e duas
+// proporções de escrita. Antes, confere que uma tarefa ALTA passa à frente de
+// uma fila de tarefas BAIXA; termina com código 1 se isso não acontecer.
+//
+// Uso: bench_escalonador [operações por cliente] [clientes]
+
+#include "containers.hpp"
+#include "escalonador.hpp"
+#include "medicao.hpp"
+#include "services.hpp"
+#include <atomic>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+constexpr int QUARTOS = 500;
+
+// Com o único trabalhador retido, uma tarefa ALTA submetida por último deve rodar antes das BAIXA
+bool conferirPrioridade(size_t tarefasBaixas) {
+    Escalonador escalonador(1);
+    promise<void> portao;
+    shared_future<void> aberto = portao.get_future().share();
+    escalonador.submeter([aberto] { aberto.wait(); });
+
+    atomic<size_t> baixasAntes{0};
+    atomic<bool> altaExecutada{false};
+    vector<future<void>> futuros;
+    for (size_t i = 0; i < tarefasBaixas; i++) {
+        futuros.push_back(escalonador.submeter([&] {
+            if (!altaExecutada.load()) baixasAntes.fetch_add(1);
+        }, Prioridade::BAIXA));
+    }
+    futuros.push_back(escalonador.submeter([&] { altaExecutada = true; }, Prioridade::ALTA));
+    portao.set_value();
+    for (auto& futuro : futuros) futuro.get();
+
+    printf("Prioridade: %zu de %zu tarefas BAIXA rodaram antes da ALTA\n", baixasAntes.load(), tarefasBaixas);
+    return baixasAntes.load() == 0;
+}
+
+void medir(size_t trabalhadores, unsigned percentualEscrita, size_t operacoes, size_t clientes) {
+    ContainerHotel hoteis;
+    ContainerQuarto quartos;
+    ContainerReserva reservas;
+    CntrMSReserva servico;
+    servico.setContainerHotel(&hoteis);
+    servico.setContainerQuarto(&quartos);
+    servico.setContainerReserva(&reservas);
+    Escalonador escalonador(trabalhadores);
+    CntrMSReservaAssincrono assincrono(&servico, &escalonador);
+
+    const Codigo hotel = gerarCodigo('H', 1);
+    servico.criarHotel(gerarHotel(1));
+    for (int numero = 1; numero <= QUARTOS; numero++) servico.criarQuarto(gerarQuarto(numero, hotel));
+
+    vector<vector<double>> porCliente(clientes);
+    atomic<size_t> proximaReserva{0};
+    Cronometro total;
+    vector<thread> threads;
+    for (size_t c = 0; c < clientes; c++) {
+        threads.emplace_back([&, c] {
+            mt19937 aleatorio(static_cast<unsigned>(c + 1));
+            vector<double>& latencias = porCliente[c];
+            latencias.reserve(operacoes);
+            for (size_t i = 0; i < operacoes; i++) {
+                const int quarto = 1 + static_cast<int>(aleatorio() % QUARTOS);
+                const int chegada = static_cast<int>(aleatorio() % 3000);
+                const unsigned sorteio = aleatorio() % 100;
+                Numero numero;
+                numero.setValor(quarto);
+
+                Cronometro cronometro;
+                if (sorteio < percentualEscrita) {
+                    assincrono.criarReserva(gerarReserva(proximaReserva++, quarto, chegada, 2)).get();
+                } else if (sorteio % 2 == 0) {
+                    assincrono.lerQuarto(numero).get();
+                } else {
+                    assincrono.cotarReserva(numero, gerarData(chegada), gerarData(chegada + 3)).get();
+                }
+                latencias.push_back(cronometro.microssegundos());
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    const double segundos = total.segundos();
+
+    vector<double> latencias;
+    for (auto& amostras : porCliente) latencias.insert(latencias.end(), amostras.begin(), amostras.end());
+    const double p50 = percentil(latencias, 50);
+    const double p99 = percentil(latencias, 99);
+    const double p999 = percentil(latencias, 99.9);
+    const EstatisticasEscalonador estatisticas = escalonador.getEstatisticas();
+    printf("%zu trabalhador(es), %2u%% escritas: %8.0f ops/s  p50 %7.1f us  p99 %7.1f us  p99.9 %7.1f us  (%zu roubadas)\n",
+           trabalhadores, percentualEscrita, latencias.size() / segundos, p50, p99, p999, estatisticas.roubadas);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t operacoes = argumento(argc, argv, 1, 20000);
+    const size_t clientes = argumento(argc, argv, 2, 8);
+
+    if (!conferirPrioridade(max<size_t>(operacoes, 1000))) {
+        printf("FALHA: tarefa ALTA esperou tarefas BAIXA.\n");
+        return 1;
+    }
+    for (size_t trabalhadores : {1, 4}) {
+        for (unsigned percentualEscrita : {10u, 50u}) medir(trabalhadores, percentualEscrita, operacoes, clientes);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Latência de promoção da lista de espera (user-047).
+//
+// Cada quarto recebe reservas de duas noites separadas por um dia livre e, para
+// cada uma, um pedido em espera pelas mesmas noites, além de pedidos que cobrem
+// duas reservas vizinhas e continuam bloqueados. As reservas são excluídas em
+// ordem aleatória, medindo deletarReserva, que já inclui a promoção. Termina
+// com código 1 se o pedido pelas noites liberadas não virar reserva.
+//
+// Uso: bench_espera [quartos] [reservas por quarto]
+
+#include "containers.hpp"
+#include "medicao.hpp"
+#include "services.hpp"
+#include <random>
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    const int quartos = static_cast<int>(min<size_t>(argumento(argc, argv, 1, 99), 999));
+    const size_t porQuarto = argumento(argc, argv, 2, 100);
+
+    ContainerHotel hoteis;
+    ContainerQuarto containerQuartos;
+    ContainerReserva reservas;
+    CntrMSReserva servico;
+    servico.setContainerHotel(&hoteis);
+    servico.setContainerQuarto(&containerQuartos);
+    servico.setContainerReserva(&reservas);
+    const Codigo hotel = gerarCodigo('H', 1);
+    servico.criarHotel(gerarHotel(1));
+
+    // Códigos: reservas em [0, n), pedidos pelas mesmas noites em [n, 2n), pedidos bloqueados em [2n, 3n)
+    const size_t total = static_cast<size_t>(quartos) * porQuarto;
+    mt19937 aleatorio(1);
+    vector<size_t> ordem;
+    for (int quarto = 1; quarto <= quartos; quarto++) {
+        servico.criarQuarto(gerarQuarto(quarto, hotel));
+        const size_t primeira = static_cast<size_t>(quarto - 1) * porQuarto;
+        for (size_t k = 0; k < porQuarto; k++) {
+            servico.criarReserva(gerarReserva(primeira + k, quarto, static_cast<int>(k) * 3, 2));
+            ordem.push_back(primeira + k);
+        }
+        for (size_t k = 0; k < porQuarto; k++) {
+            const size_t i = primeira + k;
+            const int chegada = static_cast<int>(k) * 3;
+            servico.solicitarReserva(gerarReserva(total + i, quarto, chegada, 2), aleatorio() % 4);
+            // Da segunda noite da reserva k até a primeira da k + 1
+            if (k + 1 < porQuarto) {
+                servico.solicitarReserva(gerarReserva(2 * total + i, quarto, chegada + 1, 3), aleatorio() % 4);
+            }
+        }
+    }
+    shuffle(ordem.begin(), ordem.end(), aleatorio);
+
+    vector<double> latencias;
+    latencias.reserve(ordem.size());
+    size_t naoPromovidos = 0;
+    for (size_t i : ordem) {
+        Cronometro cronometro;
+        servico.deletarReserva(gerarCodigo('R', i));
+        latencias.push_back(cronometro.microssegundos());
+
+        Reserva promovida;
+        promovida.setCodigo(gerarCodigo('R', total + i));
+        if (!reservas.pesquisar(&promovida)) naoPromovidos++;
+    }
+
+    const double p50 = percentil(latencias, 50);
+    const double p99 = percentil(latencias, 99);
+    const double maximo = percentil(latencias, 100);
+    printf("%d quartos, %zu reservas e %zu pedidos em espera por quarto\n", quartos, porQuarto, 2 * porQuarto - 1);
+    printf("deletarReserva + promocao: p50 %.1f us  p99 %.1f us  max %.1f us  (%zu nao promovidos)\n",
+           p50, p99, maximo, naoPromovidos);
+
+    if (naoPromovidos > 0) {
+        printf("FALHA: pedidos pelas noites liberadas continuaram em espera.\n");
+        return 1;
+    }
+    return 0;
+}
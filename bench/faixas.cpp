@@ -0,0 +1,144 @@
+// Reservas concorrentes com travas por faixa de quartos (user-044).
+//
+// Teste de estresse: várias threads criam, movem, solicitam e excluem
+// reservas aleatórias em poucos quartos, disputando as mesmas noites; ao fim,
+// as reservas de cada quarto são ordenadas pela chegada e nenhuma pode começar
+// antes do fim da anterior. Termina com código 1 se houver sobreposição.
+//
+// Escalonamento: mede a vazão de criarReserva com 1, 2, 4... threads, cada uma
+// em quartos de faixas próprias; o ganho só aparece com núcleos livres.
+//
+// Uso: bench_faixas [tentativas por thread] [threads]
+
+#include "containers.hpp"
+#include "medicao.hpp"
+#include "services.hpp"
+#include <atomic>
+#include <map>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+struct Ambiente {
+    ContainerHotel hoteis;
+    ContainerQuarto quartos;
+    ContainerReserva reservas;
+    CntrMSReserva servico;
+
+    explicit Ambiente(int quantidadeQuartos) {
+        servico.setContainerHotel(&hoteis);
+        servico.setContainerQuarto(&quartos);
+        servico.setContainerReserva(&reservas);
+        const Codigo hotel = gerarCodigo('H', 1);
+        servico.criarHotel(gerarHotel(1));
+        for (int numero = 1; numero <= quantidadeQuartos; numero++) servico.criarQuarto(gerarQuarto(numero, hotel));
+    }
+};
+
+// Quantidade de pares de reservas sobrepostas no mesmo quarto
+size_t contarSobreposicoes(const ContainerReserva& reservas) {
+    map<int, vector<pair<int, int>>> porQuarto;
+    reservas.percorrer([&](const Reserva& r) {
+        porQuarto[r.getQuarto().getValor()].push_back({r.getChegada().getSerial(), r.getPartida().getSerial()});
+    });
+    size_t sobreposicoes = 0;
+    for (auto& [quarto, estadias] : porQuarto) {
+        sort(estadias.begin(), estadias.end());
+        for (size_t i = 1; i < estadias.size(); i++) sobreposicoes += estadias[i].first < estadias[i - 1].second;
+    }
+    return sobreposicoes;
+}
+
+bool estressar(size_t tentativas, size_t threads) {
+    constexpr int QUARTOS = 8;
+    constexpr int DIAS = 60;
+    Ambiente ambiente(QUARTOS);
+    atomic<size_t> proximoCodigo{0};
+    atomic<size_t> criadas{0};
+
+    Cronometro cronometro;
+    vector<thread> trabalhadores;
+    for (size_t t = 0; t < threads; t++) {
+        trabalhadores.emplace_back([&, t] {
+            mt19937 aleatorio(static_cast<unsigned>(t + 1));
+            vector<size_t> minhas;
+            for (size_t i = 0; i < tentativas; i++) {
+                const int quarto = 1 + static_cast<int>(aleatorio() % QUARTOS);
+                const int chegada = static_cast<int>(aleatorio() % DIAS);
+                const int noites = 1 + static_cast<int>(aleatorio() % 4);
+                const unsigned sorteio = aleatorio() % 10;
+
+                if (sorteio < 5 || minhas.empty()) {
+                    const size_t codigo = proximoCodigo++;
+                    Reserva reserva = gerarReserva(codigo, quarto, chegada, noites);
+                    bool criada = sorteio == 0
+                        ? ambiente.servico.solicitarReserva(reserva, 0) == SituacaoSolicitacao::CRIADA
+                        : ambiente.servico.criarReserva(reserva);
+                    if (criada) {
+                        criadas++;
+                        minhas.push_back(codigo);
+                    }
+                } else if (sorteio < 8) {
+                    // Muda de quarto e de datas uma reserva já feita
+                    const size_t codigo = minhas[aleatorio() % minhas.size()];
+                    ambiente.servico.atualizarReserva(gerarReserva(codigo, quarto, chegada, noites));
+                } else {
+                    const size_t posicao = aleatorio() % minhas.size();
+                    ambiente.servico.deletarReserva(gerarCodigo('R', minhas[posicao]));
+                    minhas[posicao] = minhas.back();
+                    minhas.pop_back();
+                }
+            }
+        });
+    }
+    for (auto& t : trabalhadores) t.join();
+
+    const size_t sobreposicoes = contarSobreposicoes(ambiente.reservas);
+    printf("Estresse: %zu threads, %zu tentativas, %zu criadas, %zu reservas finais, %zu sobreposicoes (%.2f s)\n",
+           threads, threads * tentativas, criadas.load(), ambiente.reservas.listar().size(), sobreposicoes,
+           cronometro.segundos());
+    return sobreposicoes == 0;
+}
+
+// Vazão de criarReserva; a thread t usa os quartos t + 1 + 8k, então até 8
+// threads nunca disputam a mesma faixa, e as datas de cada quarto não se repetem
+double medirVazao(size_t tentativas, size_t threads) {
+    constexpr int QUARTOS_POR_THREAD = 64;
+    Ambiente ambiente(8 * QUARTOS_POR_THREAD);
+    Cronometro cronometro;
+    vector<thread> trabalhadores;
+    for (size_t t = 0; t < threads; t++) {
+        trabalhadores.emplace_back([&, t] {
+            for (size_t i = 0; i < tentativas; i++) {
+                const int quarto = static_cast<int>(t % 8) + 1 + 8 * static_cast<int>(i % QUARTOS_POR_THREAD);
+                const int chegada = static_cast<int>((t / 8) * (tentativas / QUARTOS_POR_THREAD + 1) + i / QUARTOS_POR_THREAD) * 2;
+                ambiente.servico.criarReserva(gerarReserva(t * tentativas + i, quarto, chegada, 1));
+            }
+        });
+    }
+    for (auto& t : trabalhadores) t.join();
+    return threads * tentativas / cronometro.segundos();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t tentativas = argumento(argc, argv, 1, 20000);
+    const size_t threads = argumento(argc, argv, 2, 8);
+
+    if (!estressar(tentativas, threads)) {
+        printf("FALHA: reservas sobrepostas no mesmo quarto.\n");
+        return 1;
+    }
+
+    printf("Nucleos disponiveis: %u\n", thread::hardware_concurrency());
+    const double base = medirVazao(tentativas, 1);
+    for (size_t n = 1; n <= threads; n *= 2) {
+        const double vazao = n == 1 ? base : medirVazao(tentativas, n);
+        printf("%2zu threads: %9.0f reservas/s  (%.2fx)\n", n, vazao, vazao / base);
+    }
+    return 0;
+}
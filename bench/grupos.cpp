@@ -0,0 +1,174 @@
+// Reservas de grupo com CntrMSReserva::criarReservasGrupo (user-045).
+//
+// Blocos de 200 quartos: mede a criação de grupos sem disputa, depois confere
+// as duas formas de recusa, que não podem deixar nenhuma reserva do grupo:
+//
+// - Conflito: um dos quartos já tem reserva nas mesmas noites.
+// - Corrida pela chave: enquanto o grupo é criado, outra thread inclui direto
+//   no ContainerReserva uma reserva com o código da primeira do grupo, no
+//   último quarto do grupo e nas mesmas noites. Os quartos recusados dizem em
+//   que fase ela chegou: antes da verificação (primeiro e último quartos),
+//   durante a verificação (só o último, pelas datas), entre a verificação e a
+//   confirmação (só o primeiro, pelo código, quando a Transacao desfaz as 199
+//   já incluídas) ou depois da confirmação (nenhum; a inclusão concorrente
+//   falha). O atraso da thread concorrente varre toda a duração do grupo; as
+//   tentativas continuam (até 20 vezes o pedido) enquanto a corrida entre a
+//   verificação e a confirmação não tiver acontecido.
+//
+// Termina com código 1 se um grupo recusado deixar alguma reserva, se um grupo
+// criado não estiver inteiro ou se a corrida na confirmação não acontecer.
+//
+// Uso: bench_grupos [grupos] [tentativas de corrida]
+
+#include "containers.hpp"
+#include "medicao.hpp"
+#include "services.hpp"
+#include <atomic>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+constexpr int QUARTOS_GRUPO = 200;
+
+struct Ambiente {
+    ContainerHotel hoteis;
+    ContainerQuarto quartos;
+    ContainerReserva reservas;
+    CntrMSReserva servico;
+
+    Ambiente() {
+        servico.setContainerHotel(&hoteis);
+        servico.setContainerQuarto(&quartos);
+        servico.setContainerReserva(&reservas);
+        const Codigo hotel = gerarCodigo('H', 1);
+        servico.criarHotel(gerarHotel(1));
+        for (int numero = 1; numero <= QUARTOS_GRUPO; numero++) servico.criarQuarto(gerarQuarto(numero, hotel));
+    }
+
+    size_t quantidade() const {
+        size_t total = 0;
+        reservas.percorrer([&](const Reserva&) { total++; });
+        return total;
+    }
+
+    // Reservas do grupo presentes no container, pelo código
+    size_t presentes(const vector<Reserva>& grupo) const {
+        size_t total = 0;
+        for (const auto& reserva : grupo) {
+            Reserva procurada;
+            procurada.setCodigo(reserva.getCodigo());
+            if (reservas.pesquisar(&procurada)) total++;
+        }
+        return total;
+    }
+};
+
+// Um quarto por reserva, todos nas mesmas noites; códigos a partir de primeiro
+vector<Reserva> gerarGrupo(size_t primeiro, int chegada) {
+    vector<Reserva> grupo;
+    for (int quarto = 1; quarto <= QUARTOS_GRUPO; quarto++) {
+        grupo.push_back(gerarReserva(primeiro + static_cast<size_t>(quarto - 1), quarto, chegada, 2));
+    }
+    return grupo;
+}
+
+bool contem(const vector<Numero>& numeros, int quarto) {
+    return any_of(numeros.begin(), numeros.end(), [&](const Numero& n) { return n.getValor() == quarto; });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t grupos = argumento(argc, argv, 1, 50);
+    const size_t tentativas = argumento(argc, argv, 2, 200);
+    Ambiente ambiente;
+    size_t codigo = 0;
+    int chegada = 0;
+    bool ok = true;
+
+    // 1. Grupos sem disputa
+    vector<double> latencias;
+    for (size_t g = 0; g < grupos; g++, codigo += QUARTOS_GRUPO, chegada += 3) {
+        const vector<Reserva> grupo = gerarGrupo(codigo, chegada);
+        Cronometro cronometro;
+        const vector<Numero> recusados = ambiente.servico.criarReservasGrupo(grupo);
+        latencias.push_back(cronometro.microssegundos() / 1000);
+        if (!recusados.empty() || ambiente.presentes(grupo) != grupo.size()) ok = false;
+    }
+    const double p50 = percentil(latencias, 50);
+    const double maximo = percentil(latencias, 100);
+    printf("%zu grupos de %d quartos: p50 %.2f ms  max %.2f ms\n", grupos, QUARTOS_GRUPO, p50, maximo);
+
+    // 2. Conflito de datas em um dos quartos
+    {
+        const vector<Reserva> grupo = gerarGrupo(codigo, chegada);
+        ambiente.servico.criarReserva(gerarReserva(codigo + QUARTOS_GRUPO, QUARTOS_GRUPO / 2, chegada + 1, 1));
+        const size_t antes = ambiente.quantidade();
+        const vector<Numero> recusados = ambiente.servico.criarReservasGrupo(grupo);
+        const bool intacto = ambiente.presentes(grupo) == 0 && ambiente.quantidade() == antes;
+        printf("Conflito: recusados %zu quarto(s), container %s\n", recusados.size(), intacto ? "intacto" : "ALTERADO");
+        ok &= intacto && recusados.size() == 1 && contem(recusados, QUARTOS_GRUPO / 2);
+        codigo += QUARTOS_GRUPO + 1;
+        chegada += 3;
+    }
+
+    // 3. Corrida pela chave primária
+    const double duracao = max(p50, 0.1) * 1.2; // Em ms
+    mt19937 aleatorio(1);
+    size_t antesVerificacao = 0, duranteVerificacao = 0, duranteConfirmacao = 0, depois = 0, inesperados = 0;
+    size_t t = 0;
+    for (; t < tentativas || (duranteConfirmacao == 0 && t < tentativas * 20);
+         t++, codigo += QUARTOS_GRUPO, chegada += 3) {
+        const vector<Reserva> grupo = gerarGrupo(codigo, chegada);
+        Reserva intrusa = gerarReserva(codigo, QUARTOS_GRUPO, chegada, 2);
+        const size_t antes = ambiente.quantidade();
+        const auto atraso = chrono::duration<double, milli>(duracao * (aleatorio() % 1000) / 1000.0);
+
+        atomic<bool> iniciou{false};
+        bool incluiu = false;
+        thread concorrente([&] {
+            while (!iniciou.load()) this_thread::yield();
+            const auto alvo = chrono::steady_clock::now() + atraso;
+            while (chrono::steady_clock::now() < alvo) this_thread::yield();
+            incluiu = ambiente.reservas.incluir(intrusa);
+        });
+        iniciou = true;
+        const vector<Numero> recusados = ambiente.servico.criarReservasGrupo(grupo);
+        concorrente.join();
+
+        const bool primeiro = contem(recusados, 1);
+        const bool ultimo = contem(recusados, QUARTOS_GRUPO);
+        if (recusados.empty() && !incluiu && ambiente.presentes(grupo) == grupo.size()) {
+            depois++;
+            continue;
+        }
+        // Recusado: só a intrusa pode ter entrado, e nenhuma do grupo
+        const bool intacto = incluiu && ambiente.quantidade() == antes + 1 && ambiente.presentes(grupo) == 1;
+        if (!intacto || recusados.size() > 2) {
+            inesperados++;
+        } else if (primeiro && ultimo) {
+            antesVerificacao++;
+        } else if (ultimo) {
+            duranteVerificacao++;
+        } else if (primeiro) {
+            duranteConfirmacao++;
+        } else {
+            inesperados++;
+        }
+    }
+    printf("Corrida em %zu tentativas: antes da verificacao %zu, durante a verificacao %zu, "
+           "entre verificacao e confirmacao %zu, depois %zu, inesperados %zu\n",
+           t, antesVerificacao, duranteVerificacao, duranteConfirmacao, depois, inesperados);
+    if (!ok || inesperados > 0) {
+        printf("FALHA: um grupo recusado deixou reservas ou um grupo criado ficou incompleto.\n");
+        return 1;
+    }
+    if (duranteConfirmacao == 0) {
+        printf("FALHA: a inclusao concorrente nunca caiu entre a verificacao e a confirmacao.\n");
+        return 1;
+    }
+    return 0;
+}
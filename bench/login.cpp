@@ -0,0 +1,92 @@
+// Latência de login com a conferência de senhas no VerificadorSenhas (user-037).
+//
+// Para cada nível de concorrência, clientes abrem sessões pelo caminho
+// assíncrono e medem o tempo até receber o token. Em paralelo, uma thread
+// valida uma sessão já aberta a intervalos curtos, representando as
+// requisições comuns: os percentis dela mostram se as conferências de hash
+// atrasam o restante.
+//
+// Uso: bench_login [logins por nível] [concorrência máxima]
+
+#include "containers.hpp"
+#include "medicao.hpp"
+#include "services.hpp"
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+void imprimir(const char* nome, vector<double>& amostras) {
+    const double p50 = percentil(amostras, 50);
+    const double p95 = percentil(amostras, 95);
+    const double p99 = percentil(amostras, 99);
+    const double maximo = percentil(amostras, 100);
+    printf("  %-10s %7zu amostras  p50 %9.1f us  p95 %9.1f us  p99 %9.1f us  max %9.1f us\n",
+           nome, amostras.size(), p50, p95, p99, maximo);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t logins = argumento(argc, argv, 1, 64);
+    const size_t concorrenciaMaxima = argumento(argc, argv, 2, 8);
+
+    ContainerGerente gerentes;
+    CntrMSAutenticacao autenticacao;
+    CntrMSSessao sessao;
+    autenticacao.setContainer(&gerentes);
+    sessao.setISAutenticacao(&autenticacao);
+
+    for (size_t i = 0; i < concorrenciaMaxima; i++) gerentes.incluir(gerarGerente(i));
+    Senha senha;
+    senha.setValor("A1b!2");
+    const string tokenFixo = sessao.abrirSessao(gerarGerente(0).getEmail(), senha, "medicao");
+
+    for (size_t clientes = 1; clientes <= concorrenciaMaxima; clientes *= 2) {
+        vector<vector<double>> porCliente(clientes);
+        atomic<size_t> recusados{0};
+        atomic<bool> terminou{false};
+
+        // Requisições comuns durante os logins
+        vector<double> validacoes;
+        thread requisicoes([&] {
+            while (!terminou.load(memory_order_relaxed)) {
+                Cronometro cronometro;
+                sessao.validarSessao(tokenFixo, nullptr);
+                validacoes.push_back(cronometro.microssegundos());
+                this_thread::sleep_for(chrono::microseconds(200)); // Não disputa a CPU com os logins
+            }
+        });
+
+        Cronometro total;
+        vector<thread> threads;
+        for (size_t c = 0; c < clientes; c++) {
+            threads.emplace_back([&, c] {
+                const EMAIL email = gerarGerente(c).getEmail();
+                for (size_t i = c; i < logins; i += clientes) {
+                    Cronometro cronometro;
+                    try {
+                        sessao.abrirSessaoAssincrona(email, senha, "cliente" + to_string(c)).get();
+                        porCliente[c].push_back(cronometro.microssegundos());
+                    } catch (const exception&) {
+                        recusados.fetch_add(1, memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        const double segundos = total.segundos();
+        terminou = true;
+        requisicoes.join();
+
+        vector<double> latencias;
+        for (auto& amostras : porCliente) latencias.insert(latencias.end(), amostras.begin(), amostras.end());
+        printf("%2zu clientes: %7.1f logins/s, %zu recusados\n",
+               clientes, latencias.size() / segundos, recusados.load());
+        imprimir("login", latencias);
+        imprimir("validacao", validacoes);
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+#ifndef MEDICAO_HPP_INCLUDED
+#define MEDICAO_HPP_INCLUDED
+
+#include "entities.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ====================================================================
+// UTILITÁRIOS DOS PROGRAMAS DE MEDIÇÃO
+// ====================================================================
+
+/**
+ * @class Cronometro
+ * @brief Mede o tempo decorrido desde a criação (ou o último reiniciar).
+ */
+class Cronometro {
+private:
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+
+public:
+    void reiniciar() { inicio = chrono::steady_clock::now(); }
+    double segundos() const {
+        return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    }
+    double microssegundos() const { return segundos() * 1e6; }
+};
+
+/**
+ * @brief Percentil p (0 a 100) das amostras, pelo método do posto mais próximo.
+ * @details Reordena o vetor recebido.
+ */
+inline double percentil(vector<double>& amostras, double p) {
+    if (amostras.empty()) return 0;
+    size_t posicao = static_cast<size_t>(p / 100.0 * (amostras.size() - 1) + 0.5);
+    nth_element(amostras.begin(), amostras.begin() + posicao, amostras.end());
+    return amostras[posicao];
+}
+
+/**
+ * @brief Argumento inteiro da linha de comando, ou o padrão se ausente.
+ */
+inline size_t argumento(int argc, char** argv, int indice, size_t padrao) {
+    return argc > indice ? static_cast<size_t>(strtoull(argv[indice], nullptr, 10)) : padrao;
+}
+
+// --- Geração de entidades válidas a partir de um índice ---
+
+// Palavra de letras minúsculas que codifica i em base 26, com ao menos 4 letras
+inline string palavra(size_t i) {
+    string texto;
+    do {
+        texto += static_cast<char>('a' + i % 26);
+        i /= 26;
+    } while (i > 0 || texto.size() < 4);
+    return texto;
+}
+
+inline Codigo gerarCodigo(char prefixo, size_t i) {
+    char texto[16];
+    snprintf(texto, sizeof(texto), "%c%09zu", prefixo, i % 1000000000);
+    Codigo codigo;
+    codigo.setValor(texto);
+    return codigo;
+}
+
+inline Data gerarData(int dias) {
+    Data data;
+    data.setValor(1, "JAN", 2025);
+    return data.somarDias(dias);
+}
+
+inline Hospede gerarHospede(size_t i) {
+    Hospede hospede;
+    EMAIL email;
+    email.setValor("h" + to_string(i) + "@exemplo.com");
+    string texto = palavra(i);
+    texto[0] = static_cast<char>(texto[0] - 'a' + 'A');
+    Nome nome;
+    nome.setValor("Ana " + texto);
+    Endereco endereco;
+    endereco.setValor("Rua Principal");
+    Cartao cartao;
+    cartao.setValor("4111111111111111");
+    hospede.setEmail(std::move(email));
+    hospede.setNome(std::move(nome));
+    hospede.setEndereco(std::move(endereco));
+    hospede.setCartao(std::move(cartao));
+    return hospede;
+}
+
+inline Gerente gerarGerente(size_t i, const string& textoSenha = "A1b!2") {
+    Gerente gerente;
+    EMAIL email;
+    email.setValor("g" + to_string(i) + "@hotel.com");
+    string texto = palavra(i);
+    texto[0] = static_cast<char>(texto[0] - 'a' + 'A');
+    Nome nome;
+    nome.setValor("Gerente " + texto);
+    Senha senha;
+    senha.setValor(textoSenha);
+    Ramal ramal;
+    ramal.setValor(1);
+    gerente.setEmail(std::move(email));
+    gerente.setNome(std::move(nome));
+    gerente.setSenha(std::move(senha));
+    gerente.setRamal(ramal);
+    return gerente;
+}
+
+inline Hotel gerarHotel(size_t i) {
+    Hotel hotel;
+    hotel.setCodigo(gerarCodigo('H', i));
+    Nome nome;
+    nome.setValor("Hotel Central");
+    hotel.setNome(std::move(nome));
+    return hotel;
+}
+
+inline Quarto gerarQuarto(int numero, const Codigo& hotel, long long diaria = 20000) {
+    Quarto quarto;
+    Numero n;
+    n.setValor(numero);
+    Capacidade capacidade;
+    capacidade.setValor(static_cast<unsigned short>(1 + numero % 4));
+    Dinheiro valor;
+    valor.setCentavos(diaria);
+    quarto.setNumero(n);
+    quarto.setHotel(hotel);
+    quarto.setCapacidade(capacidade);
+    quarto.setDiaria(valor);
+    return quarto;
+}
+
+inline Reserva gerarReserva(size_t i, int quarto, int chegada, int noites) {
+    Reserva reserva;
+    reserva.setCodigo(gerarCodigo('R', i));
+    Numero numero;
+    numero.setValor(quarto);
+    reserva.setQuarto(numero);
+    reserva.setChegada(gerarData(chegada));
+    reserva.setPartida(gerarData(chegada + noites));
+    Dinheiro valor;
+    valor.setCentavos(10000);
+    reserva.setValor(valor);
+    return reserva;
+}
+
+#endif // MEDICAO_HPP_INCLUDED
@@ -0,0 +1,114 @@
+// Busca de hotéis por prefixo do nome com o IndiceNomes (user-049).
+//
+// Inclui hotéis com nomes de duas palavras (muitos prefixos em comum) e depois
+// alterna renomeações, remoções e novas inclusões com consultas, de modo que
+// parte das entradas esteja no vetor ordenado e parte nas recentes. Cada
+// consulta (prefixos de 0 a 8 letras de nomes existentes, em caixa variada)
+// é comparada com uma varredura de todos os hotéis ordenada por nome em
+// minúsculas e código, e as duas são cronometradas.
+//
+// Termina com código 1 se algum resultado divergir da varredura.
+//
+// Uso: bench_prefixos [hotéis] [consultas]
+
+#include "containers.hpp"
+#include "medicao.hpp"
+#include <cctype>
+#include <random>
+
+using namespace std;
+
+namespace {
+
+string capitalizada(size_t i) {
+    string texto = palavra(i);
+    texto[0] = static_cast<char>(toupper(static_cast<unsigned char>(texto[0])));
+    return texto;
+}
+
+Hotel gerarNomeado(size_t i, size_t variante) {
+    Hotel hotel = gerarHotel(i);
+    Nome nome;
+    nome.setValor(capitalizada((i + variante) % 677) + " " + capitalizada((i * 7 + variante) % 5000));
+    hotel.setNome(std::move(nome));
+    return hotel;
+}
+
+string minusculas(const string& texto) {
+    string resultado = texto;
+    for (char& c : resultado) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    return resultado;
+}
+
+vector<string> varredura(const ContainerHotel& hoteis, const string& prefixo, size_t limite) {
+    const string chave = minusculas(prefixo);
+    vector<pair<string, string>> aceitos;
+    hoteis.percorrer([&](const Hotel& h) {
+        string nome = minusculas(h.getNome().getValor());
+        if (nome.compare(0, chave.size(), chave) == 0) aceitos.emplace_back(std::move(nome), h.getCodigo().getValor());
+    });
+    sort(aceitos.begin(), aceitos.end());
+    vector<string> codigos;
+    for (size_t i = 0; i < aceitos.size() && i < limite; i++) codigos.push_back(aceitos[i].second);
+    return codigos;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t quantidade = argumento(argc, argv, 1, 100000);
+    const size_t consultas = argumento(argc, argv, 2, 200);
+
+    ContainerHotel hoteis;
+    for (size_t i = 0; i < quantidade; i++) hoteis.incluir(gerarNomeado(i, 0));
+
+    mt19937 aleatorio(1);
+    size_t proximo = quantidade;
+    size_t renomeados = 0, removidos = 0, divergentes = 0;
+    vector<double> indice, varreduras;
+    for (size_t c = 0; c < consultas; c++) {
+        // Alterações entre as consultas: renomear, remover e incluir
+        for (int k = 0; k < 20; k++) {
+            const size_t alvo = aleatorio() % proximo;
+            switch (aleatorio() % 3) {
+                case 0: renomeados += hoteis.atualizar(gerarNomeado(alvo, 1 + aleatorio() % 50)); break;
+                case 1: removidos += hoteis.remover(gerarCodigo('H', alvo)); break;
+                default: hoteis.incluir(gerarNomeado(proximo++, 0)); break;
+            }
+        }
+
+        string prefixo = gerarNomeado(aleatorio() % proximo, aleatorio() % 50).getNome().getValor();
+        prefixo.resize(min<size_t>(prefixo.size(), aleatorio() % 9));
+        if (c % 2) prefixo = minusculas(prefixo);
+        if (c % 5 == 0) for (char& ch : prefixo) ch = static_cast<char>(toupper(static_cast<unsigned char>(ch)));
+        const size_t limite = c % 3 ? 10 : 50;
+
+        Cronometro cronometro;
+        const vector<Hotel> encontrados = hoteis.buscarPorPrefixo(prefixo, limite);
+        indice.push_back(cronometro.microssegundos());
+        cronometro.reiniciar();
+        const vector<string> esperados = varredura(hoteis, prefixo, limite);
+        varreduras.push_back(cronometro.microssegundos());
+
+        bool igual = encontrados.size() == esperados.size();
+        for (size_t i = 0; igual && i < esperados.size(); i++) igual = encontrados[i].getCodigo().getValor() == esperados[i];
+        if (!igual) {
+            divergentes++;
+            printf("Divergencia: \"%s\" limite=%zu: %zu resultados, %zu esperados\n",
+                   prefixo.c_str(), limite, encontrados.size(), esperados.size());
+        }
+    }
+
+    const double indiceP50 = percentil(indice, 50);
+    const double indiceP99 = percentil(indice, 99);
+    const double varreduraP50 = percentil(varreduras, 50);
+    printf("%zu hoteis (%zu renomeacoes, %zu remocoes), %zu consultas\n", quantidade, renomeados, removidos, consultas);
+    printf("Indice:    p50 %9.1f us  p99 %9.1f us\n", indiceP50, indiceP99);
+    printf("Varredura: p50 %9.1f us  (%zu divergentes)\n", varreduraP50, divergentes);
+
+    if (divergentes > 0) {
+        printf("FALHA: a busca por prefixo difere da varredura ordenada.\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,206 @@
+// Transações entre containers confirmadas pelo CntrMSReserva (user-042).
+//
+// Desfazer: duas transações trocam a senha de um gerente, fazem mais uma
+// alteração válida (um hóspede e uma reserva no caminho das faixas; um quarto
+// no caminho da trava exclusiva) e falham na terceira operação. A confirmação
+// deve recusar sem deixar rastro: mesmos gerentes, hóspedes, quartos e
+// reservas, com as mesmas versões, e a senha antiga continua valendo.
+//
+// Concorrência: threads confirmam transações que trocam a senha de um gerente
+// e movem uma reserva entre quartos sorteados (uma em quatro também altera um
+// quarto), enquanto outras criam reservas; mede a latência de criarReserva sem
+// e com essas confirmações. Se as travas se esperassem em ciclo, o programa
+// não terminaria (o ctest impõe um prazo). Como as senhas são derivadas antes
+// das travas, a latência das reservas não deve se aproximar do custo de um
+// hash, a menos que os dois disputem o mesmo núcleo.
+//
+// Termina com código 1 se o desfazer deixar alguma alteração.
+//
+// Uso: bench_transacoes [transações por thread] [threads]
+
+#include "containers.hpp"
+#include "medicao.hpp"
+#include "services.hpp"
+#include "transacoes.hpp"
+#include <atomic>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+constexpr int QUARTOS = 64;
+
+struct Ambiente {
+    ContainerGerente gerentes;
+    ContainerHospede hospedes;
+    ContainerHotel hoteis;
+    ContainerQuarto quartos;
+    ContainerReserva reservas;
+    CntrMSReserva servico;
+    CntrMSAutenticacao autenticacao;
+
+    explicit Ambiente(size_t quantidadeGerentes) {
+        servico.setContainerHotel(&hoteis);
+        servico.setContainerQuarto(&quartos);
+        servico.setContainerReserva(&reservas);
+        autenticacao.setContainer(&gerentes);
+        const Codigo hotel = gerarCodigo('H', 1);
+        servico.criarHotel(gerarHotel(1));
+        for (int numero = 1; numero <= QUARTOS; numero++) servico.criarQuarto(gerarQuarto(numero, hotel));
+        for (size_t i = 0; i < quantidadeGerentes; i++) gerentes.incluir(gerarGerente(i));
+    }
+
+    // Conteúdo dos containers, em ordem (o desfazer devolve entidades ao fim da lista)
+    vector<string> fotografar() const {
+        vector<string> linhas;
+        for (const auto& g : gerentes.listar()) {
+            linhas.push_back("G " + g.getEmail().getValor() + " " + g.getNome().getValor() + " " +
+                             to_string(g.getRamal().getValor()));
+        }
+        for (const auto& h : hospedes.listar()) {
+            linhas.push_back("H " + h.getEmail().getValor() + " " + h.getNome().getValor() + " v" +
+                             to_string(h.getVersao()));
+        }
+        for (const auto& q : quartos.listar()) {
+            linhas.push_back("Q " + to_string(q.getNumero().getValor()) + " " +
+                             to_string(q.getCapacidade().getValor()) + " " +
+                             to_string(q.getDiaria().getCentavos()) + " v" + to_string(q.getVersao()));
+        }
+        for (const auto& r : reservas.listar()) {
+            linhas.push_back("R " + r.getCodigo().getValor() + " " + to_string(r.getQuarto().getValor()) + " " +
+                             to_string(r.getChegada().getSerial()) + " " + to_string(r.getPartida().getSerial()) +
+                             " v" + to_string(r.getVersao()));
+        }
+        sort(linhas.begin(), linhas.end());
+        return linhas;
+    }
+};
+
+Senha gerarSenha(const string& texto) {
+    Senha senha;
+    senha.setValor(texto);
+    return senha;
+}
+
+// A terceira operação de cada transação falha; nada das anteriores pode ficar
+bool conferirDesfazer() {
+    Ambiente ambiente(1);
+    ambiente.hospedes.incluir(gerarHospede(0));
+    ambiente.servico.criarReserva(gerarReserva(0, 1, 0, 2));
+    const vector<string> antes = ambiente.fotografar();
+    const Gerente comSenhaNova = gerarGerente(0, "Z9y#8");
+    bool ok = true;
+
+    // Só reservas (além de gerente e hóspede): faixas dos quartos
+    Transacao faixas;
+    faixas.atualizar(ambiente.gerentes, comSenhaNova);
+    faixas.incluir(ambiente.reservas, gerarReserva(1, 2, 0, 2));
+    faixas.incluir(ambiente.hospedes, gerarHospede(0)); // Email repetido
+    ok &= !ambiente.servico.confirmar(faixas);
+
+    // Com quarto: trava exclusiva do serviço
+    Quarto alterado = gerarQuarto(1, gerarCodigo('H', 1), 99900);
+    Transacao exclusiva;
+    exclusiva.atualizar(ambiente.gerentes, comSenhaNova);
+    exclusiva.atualizar(ambiente.quartos, alterado);
+    exclusiva.remover(ambiente.hospedes, gerarHospede(1).getEmail()); // Inexistente
+    ok &= !ambiente.servico.confirmar(exclusiva);
+
+    const bool mesmosDados = ambiente.fotografar() == antes;
+    const EMAIL email = gerarGerente(0).getEmail();
+    const bool senhaAntiga = ambiente.autenticacao.autenticar(email, gerarSenha("A1b!2"));
+    const bool senhaNova = ambiente.autenticacao.autenticar(email, gerarSenha("Z9y#8"));
+    printf("Desfazer: confirmacoes recusadas %s, containers %s, senha antiga %s, senha nova %s\n",
+           ok ? "sim" : "NAO", mesmosDados ? "intactos" : "ALTERADOS",
+           senhaAntiga ? "aceita" : "RECUSADA", senhaNova ? "ACEITA" : "recusada");
+    return ok && mesmosDados && senhaAntiga && !senhaNova;
+}
+
+// Latência de criarReserva; com confirmadores > 0, transações concorrem com as reservas
+void medir(size_t transacoes, size_t threads, size_t confirmadores) {
+    Ambiente ambiente(confirmadores);
+    atomic<bool> terminou{false};
+    atomic<size_t> confirmadas{0};
+    atomic<size_t> recusadas{0};
+
+    vector<thread> transacionais;
+    for (size_t t = 0; t < confirmadores; t++) {
+        transacionais.emplace_back([&, t] {
+            mt19937 aleatorio(static_cast<unsigned>(t + 1));
+            const Gerente senhas[2] = {gerarGerente(t, "Z9y#8"), gerarGerente(t, "A1b!2")};
+            // Reservas próprias: códigos e datas (a partir do dia 10000) fora dos usados por criarReserva
+            size_t codigo = 500000000 + t * 1000000;
+            int quarto = 1;
+            for (size_t i = 0; i < transacoes; i++) {
+                const int destino = 1 + static_cast<int>(aleatorio() % QUARTOS);
+                const int chegada = 10000 + static_cast<int>((t * transacoes + i) * 3 % 9000);
+                Transacao transacao;
+                // Ordem de registro sorteada: a confirmação ordena as travas de qualquer forma
+                if (aleatorio() % 2) transacao.atualizar(ambiente.gerentes, senhas[i % 2]);
+                if (i > 0) transacao.remover(ambiente.reservas, gerarCodigo('R', codigo));
+                transacao.incluir(ambiente.reservas, gerarReserva(codigo + 1, destino, chegada, 2));
+                if (aleatorio() % 4 == 0) {
+                    transacao.atualizar(ambiente.quartos, gerarQuarto(quarto, gerarCodigo('H', 1)));
+                }
+                if (transacao.tamanho() < 3) transacao.atualizar(ambiente.gerentes, senhas[i % 2]);
+                if (ambiente.servico.confirmar(transacao)) {
+                    confirmadas++;
+                    codigo++;
+                    quarto = destino;
+                } else {
+                    recusadas++;
+                }
+            }
+        });
+    }
+
+    vector<vector<double>> porThread(threads);
+    vector<thread> clientes;
+    for (size_t t = 0; t < threads; t++) {
+        clientes.emplace_back([&, t] {
+            size_t i = 0;
+            // Sem confirmadores, um número fixo de reservas; com eles, até terminarem
+            while (confirmadores == 0 ? i < transacoes * 4 : !terminou.load()) {
+                const int quarto = 1 + static_cast<int>((t + i * threads) % QUARTOS);
+                const int chegada = static_cast<int>((t + i * threads) / QUARTOS) * 2;
+                Cronometro cronometro;
+                ambiente.servico.criarReserva(gerarReserva(t * 1000000 + i, quarto, chegada % 10000, 1));
+                porThread[t].push_back(cronometro.microssegundos());
+                i++;
+            }
+        });
+    }
+    for (auto& t : transacionais) t.join();
+    terminou = true;
+    for (auto& t : clientes) t.join();
+
+    vector<double> latencias;
+    for (auto& amostras : porThread) latencias.insert(latencias.end(), amostras.begin(), amostras.end());
+    const double p50 = percentil(latencias, 50);
+    const double p99 = percentil(latencias, 99);
+    const double maximo = percentil(latencias, 100);
+    printf("%zu confirmador(es): criarReserva p50 %7.1f us  p99 %7.1f us  max %8.1f us  (%zu transacoes, %zu recusadas)\n",
+           confirmadores, p50, p99, maximo, confirmadas.load(), recusadas.load());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t transacoes = argumento(argc, argv, 1, 200);
+    const size_t threads = argumento(argc, argv, 2, 4);
+
+    if (!conferirDesfazer()) {
+        printf("FALHA: a transacao recusada deixou alteracoes.\n");
+        return 1;
+    }
+
+    Cronometro hash;
+    DerivadorSenha::gerar("A1b!2");
+    printf("Nucleos disponiveis: %u; uma derivacao de senha: %.1f us\n",
+           thread::hardware_concurrency(), hash.microssegundos());
+    medir(transacoes, threads, 0);
+    medir(transacoes, threads, threads);
+    return 0;
+}
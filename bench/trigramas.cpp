@@ -0,0 +1,140 @@
+// Busca aproximada de hóspedes pelo nome com o IndiceTrigramas (user-050).
+//
+// Carrega hóspedes com nomes de poucos prenomes e sobrenomes (muitos
+// homônimos), sorteia consultas a partir de nomes existentes com 0 a 2 edições
+// e compara os primeiros resultados de buscarPorNome com uma varredura de
+// força bruta: distância de Levenshtein completa para cada hóspede, ordenada
+// por distância, nome e email. Inclui consultas com distância UINT_MAX, em que
+// todos os nomes qualificam. Informa a latência da busca indexada (a meta é
+// ficar abaixo de 5 ms com 1M de hóspedes, em build otimizado).
+//
+// Termina com código 1 se algum resultado divergir da força bruta.
+//
+// Uso: bench_trigramas [hóspedes] [consultas]
+
+#include "containers.hpp"
+#include "medicao.hpp"
+#include <cctype>
+#include <climits>
+#include <random>
+#include <tuple>
+
+using namespace std;
+
+namespace {
+
+const char* const PRENOMES[] = {"Ana", "Bruno", "Carla", "Davi", "Elisa", "Fabio", "Gabriela", "Hugo"};
+
+Hospede gerarHomonimo(size_t i, size_t sobrenomes) {
+    Hospede hospede = gerarHospede(i);
+    string sobrenome = palavra(i / 8 % sobrenomes);
+    sobrenome[0] = static_cast<char>(toupper(static_cast<unsigned char>(sobrenome[0])));
+    Nome nome;
+    nome.setValor(string(PRENOMES[i % 8]) + " " + sobrenome);
+    hospede.setNome(std::move(nome));
+    return hospede;
+}
+
+string minusculas(const string& texto) {
+    string resultado = texto;
+    for (char& c : resultado) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    return resultado;
+}
+
+// Levenshtein sem faixa nem saída antecipada
+unsigned levenshtein(const string& a, const string& b) {
+    vector<unsigned> anterior(b.size() + 1), atual(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); j++) anterior[j] = static_cast<unsigned>(j);
+    for (size_t i = 1; i <= a.size(); i++) {
+        atual[0] = static_cast<unsigned>(i);
+        for (size_t j = 1; j <= b.size(); j++) {
+            atual[j] = min({anterior[j] + 1, atual[j - 1] + 1, anterior[j - 1] + (a[i - 1] == b[j - 1] ? 0u : 1u)});
+        }
+        swap(anterior, atual);
+    }
+    return anterior[b.size()];
+}
+
+// Consulta a partir de um nome existente, com ate "edicoes" trocas, remoções ou inserções de letras
+string alterar(string nome, unsigned edicoes, mt19937& aleatorio) {
+    for (unsigned e = 0; e < edicoes; e++) {
+        const size_t posicao = aleatorio() % nome.size();
+        const char letra = static_cast<char>('a' + aleatorio() % 26);
+        switch (aleatorio() % 3) {
+            case 0: nome[posicao] = letra; break;
+            case 1: if (nome.size() > 1) nome.erase(posicao, 1); break;
+            default: nome.insert(posicao, 1, letra); break;
+        }
+    }
+    return nome;
+}
+
+struct Consulta {
+    string nome;
+    unsigned distancia;
+    size_t limite;
+};
+
+vector<EMAIL> forcaBruta(const ContainerHospede& hospedes, const Consulta& consulta) {
+    const string alvo = minusculas(consulta.nome);
+    vector<tuple<unsigned, string, EMAIL>> aceitos;
+    hospedes.percorrer([&](const Hospede& h) {
+        const string nome = minusculas(h.getNome().getValor());
+        const unsigned d = levenshtein(alvo, nome);
+        if (d <= consulta.distancia) aceitos.emplace_back(d, nome, h.getEmail());
+    });
+    sort(aceitos.begin(), aceitos.end());
+    vector<EMAIL> emails;
+    for (size_t i = 0; i < aceitos.size() && i < consulta.limite; i++) emails.push_back(get<2>(aceitos[i]));
+    return emails;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t quantidade = argumento(argc, argv, 1, 1000000);
+    const size_t consultas = argumento(argc, argv, 2, 20);
+    const size_t sobrenomes = max<size_t>(quantidade / 16, 1); // Cerca de dois homônimos por nome
+
+    ContainerHospede hospedes;
+    for (size_t i = 0; i < quantidade; i++) hospedes.incluir(gerarHomonimo(i, sobrenomes));
+
+    mt19937 aleatorio(1);
+    vector<Consulta> lote;
+    for (size_t c = 0; c < consultas; c++) {
+        const string base = gerarHomonimo(aleatorio() % quantidade, sobrenomes).getNome().getValor();
+        const unsigned edicoes = static_cast<unsigned>(c % 3);
+        // Uma em cada cinco com distância ilimitada; as demais com a distância das edições
+        const unsigned distancia = c % 5 == 4 ? UINT_MAX : edicoes;
+        lote.push_back({alterar(base, edicoes, aleatorio), distancia, c % 2 ? size_t(10) : size_t(3)});
+    }
+
+    vector<double> latencias;
+    size_t divergentes = 0;
+    for (const auto& consulta : lote) {
+        Cronometro cronometro;
+        const vector<Hospede> encontrados = hospedes.buscarPorNome(consulta.nome, consulta.distancia, consulta.limite);
+        latencias.push_back(cronometro.microssegundos() / 1000);
+
+        const vector<EMAIL> esperados = forcaBruta(hospedes, consulta);
+        bool igual = encontrados.size() == esperados.size();
+        for (size_t i = 0; igual && i < esperados.size(); i++) igual = encontrados[i].getEmail() == esperados[i];
+        if (!igual) {
+            divergentes++;
+            printf("Divergencia: \"%s\" d=%u limite=%zu: %zu resultados, %zu esperados\n",
+                   consulta.nome.c_str(), consulta.distancia, consulta.limite, encontrados.size(), esperados.size());
+        }
+    }
+
+    const double p50 = percentil(latencias, 50);
+    const double p99 = percentil(latencias, 99);
+    const double maximo = percentil(latencias, 100);
+    printf("%zu hospedes, %zu consultas: p50 %.3f ms  p99 %.3f ms  max %.3f ms  (%zu divergentes)\n",
+           quantidade, consultas, p50, p99, maximo, divergentes);
+
+    if (divergentes > 0) {
+        printf("FALHA: a busca indexada difere da forca bruta.\n");
+        return 1;
+    }
+    return 0;
+}
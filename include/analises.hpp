@@ -0,0 +1,71 @@
+#ifndef ANALISES_HPP_INCLUDED
+#define ANALISES_HPP_INCLUDED
+
+#include "interfaces.hpp" // Contém IndicadoresHotel, RelatorioOcupacao
+#include "domains.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+class Escalonador;
+
+// Forward declarations dos containers
+class ContainerHotel;
+class ContainerQuarto;
+class ContainerReserva;
+
+// ====================================================================
+// MÓDULO DE ANÁLISES (Ocupação, Receita e ADR)
+// ====================================================================
+
+/**
+ * @class BaseAnalitica
+ * @brief Cópia colunar compacta das reservas para consultas analíticas.
+ *
+ * @details As listas dos containers espalham cada reserva pela memória, junto
+ * com campos que os relatórios não usam. Em carregar(), as reservas são
+ * copiadas para vetores contíguos, um por campo (datas como serial de dias,
+ * valor em centavos e índice do hotel), com o hotel já resolvido a partir do
+ * quarto. Reservas de quartos ou hotéis inexistentes são descartadas.
+ *
+ * calcular() divide as linhas em faixas de tamanho fixo, varridas em paralelo
+ * pelo Escalonador informado ou, sem ele, por std::thread criadas na hora;
+ * cada faixa acumula em vetores próprios e os parciais são somados ao final,
+ * sem sincronização durante a varredura.
+ */
+class BaseAnalitica {
+private:
+    vector<Codigo> hoteis;
+    vector<long long> quartosPorHotel;
+
+    // Colunas das reservas (posição i de cada vetor = reserva i)
+    vector<int> chegadas;
+    vector<int> partidas;
+    vector<long long> valores;
+    vector<uint32_t> hotelDaReserva;
+
+    static constexpr size_t LINHAS_POR_TAREFA = 1 << 16; // Abaixo disso, uma thread nova não compensa
+
+    void acumular(size_t primeira, size_t ultima, int inicio, int fim,
+                  long long* noites, long long* receita) const;
+
+public:
+    /**
+     * @brief Reconstrói as colunas a partir do estado atual dos containers.
+     */
+    void carregar(const ContainerHotel& containerHoteis, const ContainerQuarto& containerQuartos,
+                  const ContainerReserva& containerReservas);
+
+    /**
+     * @brief Calcula os indicadores de cada hotel na janela [inicio, fim).
+     * @param escalonador Pool para as faixas, em Prioridade::BAIXA (nullptr = threads próprias).
+     * @throw std::invalid_argument Se a janela não tiver noites.
+     */
+    RelatorioOcupacao calcular(const Data& inicio, const Data& fim, Escalonador* escalonador = nullptr) const;
+
+    size_t getQuantidadeReservas() const { return chegadas.size(); }
+};
+
+#endif // ANALISES_HPP_INCLUDED
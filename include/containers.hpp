@@ -2,24 +2,74 @@
 #define CONTAINERS_HPP_INCLUDED
 
 #include "entities.hpp"
+#include "credenciais.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <future>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 using namespace std;
 
 // ====================================================================
 // ORGANIZAÇÃO DOS DADOS (5 CONTÊINERES)
 // ====================================================================
+//
+// Cada container tem um shared_mutex próprio: consultas pegam a trava
+// compartilhada e alterações a exclusiva, então os serviços podem ser chamados
+// de várias threads. As funções passadas a percorrer* rodam com a trava
+// compartilhada e não devem chamar métodos de alteração do mesmo container.
+// Hóspedes, hotéis, quartos e reservas são versionados (ver Versionado).
 
 /**
  * @class ContainerGerente
  * @brief Classe responsável pelo armazenamento em memória de objetos Gerente.
- * @details Simula uma tabela de banco de dados usando std::list.
+ * @details Simula uma tabela de banco de dados usando std::list, com um índice
+ * hash da chave primária (EMAIL) apontando para os elementos da lista.
+ *
+ * A senha nunca é armazenada em texto: incluir e atualizar a substituem por uma
+ * Credencial derivada nas threads do VerificadorSenhas, e os gerentes
+ * devolvidos por pesquisar e listar vêm com a senha vazia. Em atualizar, senha
+ * vazia mantém a credencial atual. Ambos lançam std::runtime_error se o
+ * verificador estiver sobrecarregado.
  */
 class ContainerGerente {
 private:
     std::list<Gerente> container;
+    mutable std::shared_mutex trava;
+    std::unordered_map<EMAIL, std::list<Gerente>::iterator> indice; // Índice da chave primária
+    std::unordered_map<EMAIL, Credencial> credenciais;              // Senhas protegidas por hash
+    const uint32_t blocosSenha;                                     // Custo das credenciais novas
+    const uint32_t rodadasSenha;
+
+    std::future<Credencial> derivar(const std::string& senha) const {
+        return VerificadorSenhas::instancia().gerar(senha, blocosSenha, rodadasSenha);
+    }
+
+    // Variantes sem trava, para quem já a detém (Transacao); a credencial vem pronta
+    bool incluirSemTrava(const Gerente& gerente, Credencial credencial);
+    bool removerSemTrava(const EMAIL& email, Gerente* removido, Credencial* credencial);
+    bool atualizarSemTrava(const Gerente& gerente, const Credencial* credencial,
+                           Gerente* anterior, Credencial* credencialAnterior);
+    friend class Transacao;
 public:
+    /**
+     * @param blocosSenha Custo de memória das senhas novas (ver DerivadorSenha).
+     * @param rodadasSenha Custo de tempo das senhas novas.
+     * @details Os padrões são os de produção; custos menores servem a cargas de
+     * teste e medições com muitos gerentes.
+     * @throw std::invalid_argument Se algum custo for zero.
+     */
+    explicit ContainerGerente(uint32_t blocosSenha = DerivadorSenha::BLOCOS_PADRAO,
+                              uint32_t rodadasSenha = DerivadorSenha::RODADAS_PADRAO);
+
     /**
      * @brief Insere um novo gerente no container.
      * @param gerente Objeto a ser inserido.
@@ -29,67 +79,471 @@ public:
     bool remover(const EMAIL& email);
     bool pesquisar(Gerente* gerente) const;
     bool atualizar(const Gerente& gerente);
-    std::list<Gerente> listar() const { return container; }
+    std::list<Gerente> listar() const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        return container;
+    }
+
+    /**
+     * @brief Aplica uma função a cada elemento armazenado (com a senha vazia), sem copiar o container.
+     */
+    template <typename Funcao>
+    void percorrer(Funcao funcao) const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        for (const auto& gerente : container) funcao(gerente);
+    }
+
+    /**
+     * @brief Recupera a credencial (sal e hash da senha) do gerente.
+     * @return true se o gerente existir.
+     */
+    bool obterCredencial(const EMAIL& email, Credencial* credencial) const;
+};
+
+// ====================================================================
+// ÍNDICE DE TRIGRAMAS (Busca aproximada de hóspedes pelo nome)
+// ====================================================================
+
+/**
+ * @class IndiceTrigramas
+ * @brief Índice invertido de trigramas dos nomes de hóspedes, para busca tolerante a erros de digitação.
+ *
+ * @details Cada nome distinto, em minúsculas e com duas marcas de borda em
+ * cada ponta, gera seus trigramas distintos; cada trigrama (15 bits, 5 por
+ * símbolo) aponta para a lista das posições dos nomes que o contêm. Hóspedes
+ * homônimos dividem a mesma posição, então nomes comuns não multiplicam as
+ * listas nem as comparações. Uma edição (inserção, remoção ou troca de letra)
+ * altera no máximo 3 trigramas, então um nome a distância d da consulta
+ * compartilha com ela ao menos T - 3d dos seus T trigramas. A busca soma as
+ * ocorrências de cada posição nas listas dos trigramas da consulta e só
+ * calcula a distância de edição (em faixa de largura 2d + 1, com saída
+ * antecipada) para as que atingem esse mínimo. Se o mínimo não passar de
+ * zero (consulta curta demais para a distância pedida), todos os nomes são
+ * comparados.
+ *
+ * Uma posição cujo último hóspede sai fica livre, mas continua nas listas (e
+ * volta a valer se o nome reaparecer); as listas são reconstruídas quando as
+ * posições livres passam da metade, o que mantém a remoção em O(1) amortizado
+ * sem buracos permanentes nas listas.
+ */
+class IndiceTrigramas {
+private:
+    static constexpr size_t TAMANHO_NOME = 20;           // Máximo do domínio Nome
+
+    struct Entrada {
+        char nome[TAMANHO_NOME];                  // Em minúsculas, sem terminador
+        unsigned char tamanho;
+        std::vector<const Hospede*> hospedes;     // Vazio = posição livre
+        std::string_view getNome() const { return std::string_view(nome, tamanho); }
+    };
+
+    static constexpr unsigned BITS_SIMBOLO = 5;
+    static constexpr size_t TRIGRAMAS = size_t(1) << (3 * BITS_SIMBOLO);
+    static constexpr size_t MAXIMO_TRIGRAMAS = 64;       // Por consulta
+    static constexpr size_t MINIMO_COMPACTACAO = 1024;   // Posições livres antes de compactar
+
+    std::vector<Entrada> entradas;                        // Posição = identificador nas listas
+    std::vector<std::vector<uint32_t>> listas;            // Trigrama -> posições
+    std::unordered_map<std::string, uint32_t> porNome;    // Nome em minúsculas -> posição
+    std::unordered_map<const Hospede*, std::pair<uint32_t, uint32_t>> posicoes; // -> (posição, índice em hospedes)
+    size_t livres = 0;
+
+    static std::string normalizar(const std::string& nome);
+    static size_t extrairTrigramas(std::string_view nome, uint16_t* trigramas);
+    static unsigned distancia(std::string_view a, std::string_view b, unsigned limite);
+    void indexar(uint32_t posicao);
+    void compactar();
+
+public:
+    IndiceTrigramas() : listas(TRIGRAMAS) {}
+
+    void incluir(const Hospede& hospede);
+
+    /**
+     * @param hospede Hóspede como está armazenado (mesmo endereço da inclusão).
+     */
+    void remover(const Hospede& hospede);
+
+    /**
+     * @brief Até limite hóspedes a no máximo distanciaMaxima edições do nome buscado.
+     * @details Sem diferenciar caixa. Ordem: menor distância, depois nome, depois email (EMAIL::operator<).
+     * Qualquer distanciaMaxima é aceita; acima do maior tamanho possível, todos os nomes qualificam.
+     */
+    std::vector<const Hospede*> buscar(const std::string& nome, unsigned distanciaMaxima, size_t limite) const;
 };
 
 /**
  * @class ContainerHospede
  * @brief Classe responsável pelo armazenamento em memória de objetos Hospede.
+ * @details Mantém, além do índice da chave primária, um IndiceTrigramas para a
+ * busca aproximada pelo nome.
  */
 class ContainerHospede {
 private:
     std::list<Hospede> container;
+    mutable std::shared_mutex trava;
+    std::unordered_map<EMAIL, std::list<Hospede>::iterator> indice; // Índice da chave primária
+    IndiceTrigramas nomes;
+
+    // Variantes sem trava, para quem já a detém (Transacao)
+    bool incluirSemTrava(const Hospede& hospede);
+    bool removerSemTrava(const EMAIL& email, Hospede* removido);
+    ResultadoAtualizacao atualizarSemTrava(const Hospede& hospede, Hospede* anterior,
+                                           const unsigned long long* versaoEsperada);
+    void restaurarSemTrava(const Hospede& hospede); // Grava como recebida, versão inclusive (desfazer)
+    friend class Transacao;
 public:
     bool incluir(const Hospede& hospede);
     bool remover(const EMAIL& email);
     bool pesquisar(Hospede* hospede) const;
     bool atualizar(const Hospede& hospede);
-    std::list<Hospede> listar() const { return container; }
+
+    /**
+     * @brief Atualiza só se a versão armazenada for a esperada (compare-and-swap).
+     */
+    ResultadoAtualizacao atualizar(const Hospede& hospede, unsigned long long versaoEsperada);
+
+    /**
+     * @brief Hóspedes cujo nome está a no máximo distanciaMaxima edições do buscado, do mais próximo ao mais distante.
+     */
+    std::vector<Hospede> buscarPorNome(const std::string& nome, unsigned distanciaMaxima, size_t limite) const;
+    std::list<Hospede> listar() const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        return container;
+    }
+
+    /**
+     * @brief Aplica uma função a cada elemento armazenado, sem copiar o container.
+     */
+    template <typename Funcao>
+    void percorrer(Funcao funcao) const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        for (const auto& hospede : container) funcao(hospede);
+    }
+};
+
+// ====================================================================
+// ÍNDICE DE PREFIXOS (Busca de hotéis pelo início do nome)
+// ====================================================================
+
+/**
+ * @class IndiceNomes
+ * @brief Nomes de hotéis em minúsculas, ordenados, para busca por prefixo sem diferenciar caixa.
+ *
+ * @details Cada entrada ocupa 32 bytes: o nome (no máximo 20 letras, pelas
+ * regras de Nome) em um vetor de tamanho fixo, sem alocação, e um ponteiro
+ * para o hotel na lista do container, estável enquanto ele existir. A busca é
+ * binária sobre o vetor ordenado, seguida da leitura das entradas contíguas
+ * que começam pelo prefixo.
+ *
+ * Inserir no meio de um vetor ordenado custa O(n); para que a carga de muitos
+ * hotéis não fique quadrática, as inclusões vão para um vetor de recentes, fora
+ * de ordem, que a busca percorre inteiro e que é ordenado e fundido ao
+ * principal ao atingir LIMITE_RECENTES entradas.
+ */
+class IndiceNomes {
+private:
+    struct Entrada {
+        char chave[20];           // Nome em minúsculas, sem terminador
+        unsigned char tamanho;
+        const Hotel* hotel;
+        std::string_view getChave() const { return std::string_view(chave, tamanho); }
+    };
+
+    static constexpr size_t LIMITE_RECENTES = 1024;
+
+    std::vector<Entrada> ordenadas; // Por nome e, no empate, por código
+    std::vector<Entrada> recentes;
+
+    static Entrada criarEntrada(const Hotel& hotel);
+    static bool precede(const Entrada& a, const Entrada& b);
+    void fundir();
+
+public:
+    void incluir(const Hotel& hotel);
+
+    /**
+     * @param hotel Hotel como está armazenado (mesmo endereço e nome da inclusão).
+     */
+    void remover(const Hotel& hotel);
+
+    /**
+     * @brief Até limite hotéis cujo nome começa pelo prefixo, em ordem alfabética.
+     */
+    std::vector<const Hotel*> buscar(const std::string& prefixo, size_t limite) const;
 };
 
 /**
  * @class ContainerHotel
  * @brief Classe responsável pelo armazenamento em memória de objetos Hotel.
+ * @details Mantém, além do índice da chave primária, um IndiceNomes para a
+ * busca por prefixo do nome.
  */
 class ContainerHotel {
 private:
     std::list<Hotel> container;
+    mutable std::shared_mutex trava;
+    std::unordered_map<Codigo, std::list<Hotel>::iterator> indice; // Índice da chave primária
+    IndiceNomes nomes;
+
+    // Variantes sem trava, para quem já a detém (Transacao)
+    bool incluirSemTrava(const Hotel& hotel);
+    bool removerSemTrava(const Codigo& codigo, Hotel* removido);
+    ResultadoAtualizacao atualizarSemTrava(const Hotel& hotel, Hotel* anterior,
+                                           const unsigned long long* versaoEsperada);
+    void restaurarSemTrava(const Hotel& hotel); // Grava como recebida, versão inclusive (desfazer)
+    friend class Transacao;
 public:
     bool incluir(const Hotel& hotel);
     bool remover(const Codigo& codigo);
     bool pesquisar(Hotel* hotel) const;
     bool atualizar(const Hotel& hotel);
-    std::list<Hotel> listar() const { return container; }
+
+    /**
+     * @brief Atualiza só se a versão armazenada for a esperada (compare-and-swap).
+     */
+    ResultadoAtualizacao atualizar(const Hotel& hotel, unsigned long long versaoEsperada);
+
+    /**
+     * @brief Até limite hotéis cujo nome começa pelo prefixo (sem diferenciar caixa), em ordem alfabética.
+     */
+    std::vector<Hotel> buscarPorPrefixo(const std::string& prefixo, size_t limite) const;
+    std::list<Hotel> listar() const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        return container;
+    }
+
+    /**
+     * @brief Aplica uma função a cada elemento armazenado, sem copiar o container.
+     */
+    template <typename Funcao>
+    void percorrer(Funcao funcao) const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        for (const auto& hotel : container) funcao(hotel);
+    }
+};
+
+// ====================================================================
+// ESPELHOS COLUNARES (Structure of Arrays)
+// ====================================================================
+
+/**
+ * @class ColunasQuarto
+ * @brief Espelho colunar dos campos de Quarto usados em filtros e agregações.
+ *
+ * @details A posição i de cada vetor descreve o mesmo quarto. Os laços sobre
+ * esses vetores percorrem memória contígua de tipos primitivos e podem ser
+ * vetorizados pelo compilador, ao contrário da lista de objetos completos.
+ * Remoções movem a última linha para a posição liberada, então a ordem das
+ * linhas não acompanha a da lista.
+ */
+class ColunasQuarto {
+private:
+    std::vector<int> numeros;
+    std::vector<unsigned short> capacidades;
+    std::vector<long long> diarias;              // Em centavos
+    std::unordered_map<int, size_t> posicao;     // Número -> linha
+public:
+    void incluir(const Quarto& quarto);
+    void remover(const Numero& numero);
+    void atualizar(const Quarto& quarto);
+
+    size_t tamanho() const { return numeros.size(); }
+    const std::vector<int>& getNumeros() const { return numeros; }
+    const std::vector<unsigned short>& getCapacidades() const { return capacidades; }
+    const std::vector<long long>& getDiarias() const { return diarias; }
+
+    /**
+     * @brief Conta os quartos com capacidade maior ou igual à mínima.
+     */
+    size_t contarPorCapacidade(unsigned short minima) const;
+};
+
+/**
+ * @class ColunasReserva
+ * @brief Espelho colunar dos campos de Reserva usados em filtros e agregações.
+ *
+ * @details Datas ficam como serial de dias e valores em centavos. O código só
+ * é guardado para localizar a linha movida em uma remoção.
+ */
+class ColunasReserva {
+private:
+    std::vector<Codigo> codigos;
+    std::vector<int> quartos;
+    std::vector<int> chegadas;
+    std::vector<int> partidas;
+    std::vector<long long> valores;              // Em centavos
+    std::unordered_map<Codigo, size_t> posicao;  // Código -> linha
+public:
+    void incluir(const Reserva& reserva);
+    void remover(const Codigo& codigo);
+    void atualizar(const Reserva& reserva);
+
+    size_t tamanho() const { return codigos.size(); }
+    const std::vector<int>& getQuartos() const { return quartos; }
+    const std::vector<int>& getChegadas() const { return chegadas; }
+    const std::vector<int>& getPartidas() const { return partidas; }
+    const std::vector<long long>& getValores() const { return valores; }
+
+    /**
+     * @brief Soma, em centavos, o valor das reservas com chegada em [inicio, fim).
+     * @param inicio Serial do primeiro dia.
+     * @param fim Serial do dia seguinte ao último.
+     */
+    long long somarValores(int inicio, int fim) const;
 };
 
 /**
  * @class ContainerQuarto
  * @brief Classe responsável pelo armazenamento em memória de objetos Quarto.
+ * @details Além do índice da chave primária, mantém um índice reverso da chave
+ * estrangeira (hotel), para localizar os quartos de um hotel sem varrer a lista.
  */
 class ContainerQuarto {
 private:
     std::list<Quarto> container;
+    mutable std::shared_mutex trava;
+    std::unordered_map<Numero, std::list<Quarto>::iterator> indice; // Índice da chave primária
+    std::unordered_map<Codigo, std::vector<std::list<Quarto>::iterator>> porHotel; // Índice reverso
+    std::unique_ptr<ColunasQuarto> colunas; // Espelho colunar opcional (nulo se desabilitado)
+
+    // Variantes sem trava, para quem já a detém (Transacao)
+    bool incluirSemTrava(const Quarto& quarto);
+    bool removerSemTrava(const Numero& numero, Quarto* removido);
+    ResultadoAtualizacao atualizarSemTrava(const Quarto& quarto, Quarto* anterior,
+                                           const unsigned long long* versaoEsperada);
+    void restaurarSemTrava(const Quarto& quarto); // Grava como recebida, versão inclusive (desfazer)
+    friend class Transacao;
 public:
     bool incluir(const Quarto& quarto);
     bool remover(const Numero& numero);
     bool pesquisar(Quarto* quarto) const;
     bool atualizar(const Quarto& quarto);
-    std::list<Quarto> listar() const { return container; }
+
+    /**
+     * @brief Atualiza só se a versão armazenada for a esperada (compare-and-swap).
+     */
+    ResultadoAtualizacao atualizar(const Quarto& quarto, unsigned long long versaoEsperada);
+    std::list<Quarto> listar() const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        return container;
+    }
+
+    /**
+     * @brief Números dos quartos de um hotel, em tempo proporcional à quantidade deles.
+     */
+    std::vector<Numero> listarPorHotel(const Codigo& hotel) const;
+
+    /**
+     * @brief Aplica uma função a cada elemento armazenado, sem copiar o container.
+     */
+    template <typename Funcao>
+    void percorrer(Funcao funcao) const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        for (const auto& quarto : container) funcao(quarto);
+    }
+
+    /**
+     * @brief Cria o espelho colunar a partir do conteúdo atual.
+     * @details A partir daí, incluir, remover e atualizar mantêm o espelho sincronizado.
+     */
+    void habilitarColunas();
+
+    /**
+     * @brief Acesso ao espelho colunar, com a trava de leitura do container.
+     * @details A função recebe um ponteiro para as colunas, ou nullptr se o
+     * espelho não estiver habilitado; o ponteiro só vale durante a chamada.
+     */
+    template <typename Funcao>
+    void lerColunas(Funcao funcao) const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        funcao(static_cast<const ColunasQuarto*>(colunas.get()));
+    }
 };
 
 /**
  * @class ContainerReserva
  * @brief Classe responsável pelo armazenamento em memória de objetos Reserva.
+ * @details Além do índice da chave primária, mantém um índice reverso da chave
+ * estrangeira (quarto), para localizar as reservas de um quarto sem varrer a lista.
  */
 class ContainerReserva {
 private:
     std::list<Reserva> container;
+    mutable std::shared_mutex trava;
+    std::unordered_map<Codigo, std::list<Reserva>::iterator> indice; // Índice da chave primária
+    std::unordered_map<Numero, std::vector<std::list<Reserva>::iterator>> porQuarto; // Índice reverso
+    std::unique_ptr<ColunasReserva> colunas; // Espelho colunar opcional (nulo se desabilitado)
+
+    // Variantes sem trava, para quem já a detém (Transacao)
+    bool incluirSemTrava(const Reserva& reserva);
+    bool removerSemTrava(const Codigo& codigo, Reserva* removido);
+    ResultadoAtualizacao atualizarSemTrava(const Reserva& reserva, Reserva* anterior,
+                                           const unsigned long long* versaoEsperada);
+    void restaurarSemTrava(const Reserva& reserva); // Grava como recebida, versão inclusive (desfazer)
+    friend class Transacao;
 public:
     bool incluir(const Reserva& reserva);
     bool remover(const Codigo& codigo);
     bool pesquisar(Reserva* reserva) const;
     bool atualizar(const Reserva& reserva);
-    std::list<Reserva> listar() const { return container; }
+
+    /**
+     * @brief Atualiza só se a versão armazenada for a esperada (compare-and-swap).
+     */
+    ResultadoAtualizacao atualizar(const Reserva& reserva, unsigned long long versaoEsperada);
+    std::list<Reserva> listar() const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        return container;
+    }
+
+    /**
+     * @brief Códigos das reservas de um quarto, em tempo proporcional à quantidade delas.
+     */
+    std::vector<Codigo> listarPorQuarto(const Numero& quarto) const;
+
+    /**
+     * @brief Remove todas as reservas de um quarto de uma vez (exclusão em cascata).
+     * @return Quantidade de reservas removidas.
+     */
+    size_t removerPorQuarto(const Numero& quarto);
+
+    /**
+     * @brief Aplica uma função a cada reserva do quarto, sem copiá-las.
+     */
+    template <typename Funcao>
+    void percorrerPorQuarto(const Numero& quarto, Funcao funcao) const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        auto it = porQuarto.find(quarto);
+        if (it == porQuarto.end()) return;
+        for (const auto& reserva : it->second) funcao(*reserva);
+    }
+
+    /**
+     * @brief Aplica uma função a cada elemento armazenado, sem copiar o container.
+     */
+    template <typename Funcao>
+    void percorrer(Funcao funcao) const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        for (const auto& reserva : container) funcao(reserva);
+    }
+
+    /**
+     * @brief Cria o espelho colunar a partir do conteúdo atual.
+     * @details A partir daí, incluir, remover e atualizar mantêm o espelho sincronizado.
+     */
+    void habilitarColunas();
+
+    /**
+     * @brief Acesso ao espelho colunar, com a trava de leitura do container.
+     * @details A função recebe um ponteiro para as colunas, ou nullptr se o
+     * espelho não estiver habilitado; o ponteiro só vale durante a chamada.
+     */
+    template <typename Funcao>
+    void lerColunas(Funcao funcao) const {
+        std::shared_lock<std::shared_mutex> bloqueio(trava);
+        funcao(static_cast<const ColunasReserva*>(colunas.get()));
+    }
 };
 
 #endif // CONTAINERS_HPP_INCLUDED
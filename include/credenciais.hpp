@@ -0,0 +1,177 @@
+#ifndef CREDENCIAIS_HPP_INCLUDED
+#define CREDENCIAIS_HPP_INCLUDED
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// ====================================================================
+// MÓDULO DE CREDENCIAIS (Hash de senhas)
+// ====================================================================
+
+/// Resumo SHA-256 (32 bytes).
+using Resumo = array<uint8_t, 32>;
+
+/**
+ * @class Sha256
+ * @brief Implementação local do SHA-256 (FIPS 180-4), em modo incremental.
+ */
+class Sha256 {
+private:
+    uint32_t estado[8];
+    uint8_t bloco[64];
+    size_t usados;          // Bytes pendentes em bloco
+    uint64_t totalBytes;
+
+    void comprimir(const uint8_t* dados);
+
+public:
+    Sha256();
+
+    /**
+     * @brief Acrescenta bytes à mensagem.
+     */
+    void atualizar(const void* dados, size_t tamanho);
+
+    /**
+     * @brief Conclui o cálculo e devolve o resumo. O objeto não deve ser reutilizado.
+     */
+    Resumo finalizar();
+};
+
+/**
+ * @struct Credencial
+ * @brief Senha protegida: sal aleatório, parâmetros de custo e resumo derivado.
+ *
+ * @details Os parâmetros ficam junto do resumo para que credenciais antigas
+ * continuem verificáveis se os custos padrão mudarem.
+ */
+struct Credencial {
+    uint32_t blocos = 0;        ///< Custo de memória, em blocos de 32 bytes (0 = vazia).
+    uint32_t rodadas = 0;       ///< Custo de tempo, em passagens sobre a memória.
+    array<uint8_t, 16> sal{};
+    Resumo resumo{};
+
+    bool vazia() const { return blocos == 0; }
+};
+
+/**
+ * @class DerivadorSenha
+ * @brief Função de derivação de senhas com custo de memória (Balloon Hashing sobre SHA-256).
+ *
+ * @details Segue o algoritmo de Boneh, Corrigan-Gibbs e Schechter: um buffer de
+ * blocos é preenchido em sequência a partir da senha e do sal e depois
+ * misturado por várias rodadas, em que cada bloco depende do anterior e de
+ * blocos escolhidos de forma pseudoaleatória. Com os custos padrão, cada
+ * derivação usa 64 KiB e milhares de chamadas ao SHA-256.
+ */
+class DerivadorSenha {
+private:
+    static constexpr uint32_t VIZINHOS = 3; // Blocos pseudoaleatórios misturados por passo
+
+    static Resumo derivar(const string& senha, const array<uint8_t, 16>& sal,
+                          uint32_t blocos, uint32_t rodadas);
+
+public:
+    static constexpr uint32_t BLOCOS_PADRAO = 2048; // 64 KiB
+    static constexpr uint32_t RODADAS_PADRAO = 3;
+
+    /**
+     * @brief Gera uma credencial com sal novo, obtido de std::random_device.
+     */
+    static Credencial gerar(const string& senha, uint32_t blocos = BLOCOS_PADRAO,
+                            uint32_t rodadas = RODADAS_PADRAO);
+
+    /**
+     * @brief Confere a senha contra a credencial, comparando em tempo constante.
+     * @return false também para credencial vazia.
+     */
+    static bool conferir(const Credencial& credencial, const string& senha);
+};
+
+/**
+ * @class VerificadorSenhas
+ * @brief Conjunto fixo de threads dedicado a conferir senhas.
+ *
+ * @details O custo de cada conferência e de cada derivação é alto de propósito;
+ * isolá-las em poucas threads limita a CPU e a memória gastas com senhas, e a
+ * fila limitada recusa pedidos excedentes na hora em vez de acumulá-los. O
+ * processo usa um conjunto único (instancia()), compartilhado pelo login e
+ * pelo cadastro de gerentes.
+ */
+class VerificadorSenhas {
+private:
+    vector<thread> trabalhadores;
+    deque<function<void()>> fila;
+    size_t capacidadeFila;
+    mutex trava;
+    condition_variable temTarefa;
+    bool encerrando = false;
+
+    void executar();
+    void enfileirar(function<void()> tarefa);
+
+public:
+    /**
+     * @param quantidadeThreads Threads de verificação (0 = metade dos núcleos, ao menos 1).
+     * @param capacidadeFila Pedidos aguardando além dos que estão em execução.
+     */
+    explicit VerificadorSenhas(size_t quantidadeThreads = 0, size_t capacidadeFila = 256);
+    ~VerificadorSenhas();
+
+    VerificadorSenhas(const VerificadorSenhas&) = delete;
+    VerificadorSenhas& operator=(const VerificadorSenhas&) = delete;
+
+    /**
+     * @brief Retorna o conjunto único do processo.
+     */
+    static VerificadorSenhas& instancia();
+
+    /**
+     * @brief Agenda uma função para uma das threads de verificação.
+     * @details A função não deve esperar por outras tarefas deste conjunto.
+     * @return Futuro com o resultado da função (ou a exceção que ela lançar).
+     * @throw std::runtime_error Se a fila estiver cheia.
+     */
+    template <typename Funcao>
+    future<typename result_of<Funcao()>::type> submeter(Funcao funcao);
+
+    /**
+     * @brief Agenda a conferência da senha.
+     * @return Futuro com o resultado de DerivadorSenha::conferir.
+     * @throw std::runtime_error Se a fila estiver cheia.
+     */
+    future<bool> conferir(const Credencial& credencial, const string& senha);
+
+    /**
+     * @brief Agenda a derivação de uma credencial nova para a senha.
+     * @return Futuro com o resultado de DerivadorSenha::gerar.
+     * @throw std::runtime_error Se a fila estiver cheia.
+     */
+    future<Credencial> gerar(const string& senha, uint32_t blocos = DerivadorSenha::BLOCOS_PADRAO,
+                             uint32_t rodadas = DerivadorSenha::RODADAS_PADRAO);
+};
+
+template <typename Funcao>
+future<typename result_of<Funcao()>::type> VerificadorSenhas::submeter(Funcao funcao) {
+    using Resultado = typename result_of<Funcao()>::type;
+    // packaged_task não é copiável; o shared_ptr permite guardá-la em std::function
+    auto tarefa = make_shared<packaged_task<Resultado()>>(std::move(funcao));
+    future<Resultado> resultado = tarefa->get_future();
+    enfileirar([tarefa] { (*tarefa)(); });
+    return resultado;
+}
+
+#endif // CREDENCIAIS_HPP_INCLUDED
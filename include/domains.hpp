@@ -3,10 +3,65 @@
 
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
 
 using namespace std;
 
+/**
+ * @class Caractere
+ * @brief Classificação de caracteres ASCII utilizável em tempo de compilação.
+ *
+ * @details Equivalentes constexpr de isdigit, isupper, islower, isalpha e isalnum,
+ * independentes do locale configurado no processo.
+ */
+class Caractere {
+    public:
+        static constexpr bool ehDigito(char c) { return c >= '0' && c <= '9'; }
+        static constexpr bool ehMaiuscula(char c) { return c >= 'A' && c <= 'Z'; }
+        static constexpr bool ehMinuscula(char c) { return c >= 'a' && c <= 'z'; }
+        static constexpr bool ehLetra(char c) { return ehMaiuscula(c) || ehMinuscula(c); }
+        static constexpr bool ehAlfanumerico(char c) { return ehLetra(c) || ehDigito(c); }
+        static constexpr char paraMaiuscula(char c) { return ehMinuscula(c) ? c - ('a' - 'A') : c; }
+};
+
+/**
+ * @class Literal
+ * @brief Valor de um domínio verificado em tempo de compilação.
+ *
+ * @details Cada domínio expõe uma função constexpr verificar, com as mesmas regras de
+ * validar, e o tipo ValorLiteral aceito por ela. Declarado como constexpr, um Literal
+ * inválido interrompe a compilação, pois a exceção lançada no construtor não pode ser
+ * avaliada em uma expressão constante. Os domínios aceitam o Literal em setValor sem
+ * repetir a validação. Fora de um contexto constexpr, o construtor valida em tempo de
+ * execução e lança std::invalid_argument, como setValor.
+ *
+ * @code
+ * constexpr Literal<Nome> NOME_ADMIN("Administrador");
+ * Nome nome;
+ * nome.setValor(NOME_ADMIN);
+ * @endcode
+ */
+template <class Dominio>
+class Literal {
+    public:
+        using Valor = typename Dominio::ValorLiteral;
+
+        constexpr explicit Literal(Valor valor) : valor(valor) {
+            if (const char* erro = Dominio::verificar(valor)) throw invalid_argument(erro);
+        }
+
+        constexpr Valor getValor() const { return valor; }
+    private:
+        Valor valor;
+};
+
 /**
  * @class Numero
  * @brief Domínio para representar o Número do Quarto em um Hotel.
@@ -17,7 +72,7 @@ using namespace std;
  */
 class Numero {
     private:
-        int valor;
+        int valor = 0;
         /**
          * @brief Valida o número do quarto.
          * @param valor Inteiro a ser validado.
@@ -25,6 +80,15 @@ class Numero {
          */
         void validar(int valor);
     public:
+        using ValorLiteral = int;
+
+        /**
+         * @brief Aplica as regras de validar sem lançar exceção; pode ser avaliado em tempo de compilação.
+         * @param valor Inteiro a ser verificado.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(int valor);
+
         /**
          * @brief Define o número do quarto.
          * @param novoValor Inteiro entre 1 e 999.
@@ -32,17 +96,36 @@ class Numero {
          */
         void setValor(int novoValor);
 
+        /**
+         * @brief Define o valor a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Numero>& literal);
+
         /**
          * @brief Retorna o número do quarto.
          * @return int Valor do número.
          */
         int getValor() const;
+
+        bool operator==(const Numero& outro) const { return valor == outro.valor; }
+        bool operator!=(const Numero& outro) const { return valor != outro.valor; }
+        bool operator<(const Numero& outro) const { return valor < outro.valor; }
+        bool operator>(const Numero& outro) const { return valor > outro.valor; }
+        bool operator<=(const Numero& outro) const { return valor <= outro.valor; }
+        bool operator>=(const Numero& outro) const { return valor >= outro.valor; }
 };
 
 inline int Numero::getValor() const {
     return valor;
 }
 
+constexpr const char* Numero::verificar(int valor) {
+    if(valor < 1 || valor > 999) {
+        return "Numero invalido. O valor deve estar entre 1 e 999.";
+    }
+    return nullptr;
+}
+
 /**
  * @class Senha
  * @brief Domínio para armazenar e validar a Senha do Gerente.
@@ -63,6 +146,15 @@ class Senha {
          */
         void validar(const string& valor);
     public:
+        using ValorLiteral = string_view;
+
+        /**
+         * @brief Verifica as regras de complexidade sem lançar exceção; utilizável em expressões constantes.
+         * @param valor Texto da senha.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(string_view valor);
+
         /**
          * @brief Define a senha.
          * @param novoValor String contendo a senha.
@@ -70,17 +162,63 @@ class Senha {
          */
         void setValor(const string& novoValor);
 
+        /**
+         * @brief Define o valor a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Senha>& literal);
+
         /**
          * @brief Retorna a senha armazenada.
-         * @return string Senha.
+         * @return const string& Senha.
          */
-        string getValor() const;
+        const string& getValor() const;
 };
 
-inline string Senha::getValor() const {
+inline const string& Senha::getValor() const {
     return valor;
 }
 
+constexpr const char* Senha::verificar(string_view valor) {
+    const size_t TAMANHO = 5;
+
+    if(valor.length() != TAMANHO) {
+        return "Senha deve conter exatamente 5 caracteres.";
+    }
+
+    bool temDigito = false;
+    bool temMaiuscula = false;
+    bool temMinuscula = false;
+    bool temEspecial = false;
+
+    const string_view CARACTERES_ESPECIAIS = "!\"#$%&?";
+
+    for(char c : valor) {
+        if (Caractere::ehDigito(c)) temDigito = true;
+        else if (Caractere::ehMaiuscula(c)) temMaiuscula = true;
+        else if (Caractere::ehMinuscula(c)) temMinuscula = true;
+        else if (CARACTERES_ESPECIAIS.find(c) != string_view::npos) temEspecial = true;
+        else return "Caracter invalido na senha.";
+    }
+
+    if(!temDigito || !temMaiuscula || !temMinuscula || !temEspecial) {
+        return "Senha deve conter pelo menos uma letra minuscula, uma maiuscula, um digito e um caracter especial.";
+    }
+
+    // Verifica caracteres sequenciais repetidos (tipo por tipo)
+    for(size_t i = 0; i < valor.length() - 1; i++) {
+        char atual = valor[i];
+        char proximo = valor[i+1];
+
+        if(Caractere::ehLetra(atual) && Caractere::ehLetra(proximo)) {
+            return "Letra nao pode ser seguida por letra.";
+        }
+        if(Caractere::ehDigito(atual) && Caractere::ehDigito(proximo)) {
+            return "Digito nao pode ser seguido por digito.";
+        }
+    }
+    return nullptr;
+}
+
 /**
  * @class Endereco
  * @brief Domínio para armazenar e validar o Endereço.
@@ -100,6 +238,15 @@ class Endereco {
          */
         void validar(const string& valor);
     public:
+        using ValorLiteral = string_view;
+
+        /**
+         * @brief Verifica o formato do endereço sem lançar exceção (constexpr).
+         * @param valor Texto do endereço.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(string_view valor);
+
         /**
          * @brief Define o endereço.
          * @param novoValor String do endereço.
@@ -107,17 +254,60 @@ class Endereco {
          */
         void setValor(const string& novoValor);
 
+        /**
+         * @brief Define o valor a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Endereco>& literal);
+
         /**
          * @brief Retorna o endereço armazenado.
-         * @return string Endereço.
+         * @return const string& Endereço.
          */
-        string getValor() const;
+        const string& getValor() const;
 };
 
-inline string Endereco::getValor() const {
+inline const string& Endereco::getValor() const {
     return valor;
 }
 
+constexpr const char* Endereco::verificar(string_view valor) {
+    const size_t TAMANHO_MIN = 5;
+    const size_t TAMANHO_MAX = 30;
+    const string_view CARACTERES_ESPECIAIS = ",. ";
+
+    if(valor.length() < TAMANHO_MIN || valor.length() > TAMANHO_MAX) {
+        return "Endereco deve conter entre 5 e 30 caracteres.";
+    }
+
+    for(size_t i = 0; i < valor.length(); i++) {
+        char c = valor[i];
+
+        if (!(Caractere::ehAlfanumerico(c) || CARACTERES_ESPECIAIS.find(c) != string_view::npos)) {
+            return "Caracter invalido no endereco.";
+        }
+
+        if((i == 0 || i == valor.length()-1) && CARACTERES_ESPECIAIS.find(c) != string_view::npos) {
+            return "Primeiro e ultimo caracter nao pode ser virgula, ponto ou espaco em branco.";
+        }
+    }
+
+    for(size_t i = 0; i < valor.length() - 1; i++) {
+        char atual = valor[i];
+        char proximo = valor[i+1];
+
+        if(atual == ',' && (proximo == ',' || proximo == '.')) {
+            return "Virgula nao pode ser seguida por virgula ou ponto.";
+        }
+        if(atual == '.' && (proximo == ',' || proximo == '.')) {
+            return "Ponto nao pode ser seguido por virgula ou ponto.";
+        }
+        if(atual == ' ' && !Caractere::ehAlfanumerico(proximo)) {
+            return "Espaco em branco deve ser seguido por letra ou digito.";
+        }
+    }
+    return nullptr;
+}
+
 /**
  * @class Dinheiro
  * @brief Domínio para representar valores monetários.
@@ -125,17 +315,38 @@ inline string Endereco::getValor() const {
  * @details Regras de negócio:
  * - Valor entre 0,01 e 1.000.000,00.
  * - O armazenamento interno é realizado em inteiros (centavos - long long) para evitar erros de arredondamento típicos de ponto flutuante.
+ *
+ * A leitura de texto e todas as operações aritméticas trabalham diretamente em centavos,
+ * sem passar por double. Percentuais são expressos em pontos-base (1 ponto-base = 0,01%)
+ * e arredondados para o centavo mais próximo, com empates arredondados para cima.
  */
 class Dinheiro {
     private:
-        long long valor; // Armazena em centavos para precisão
+        long long valor = 0; // Armazena em centavos para precisão
         /**
          * @brief Valida se o valor em centavos está dentro do limite permitido.
          * @param valor Valor em centavos.
          * @throw std::invalid_argument Se fora do intervalo.
          */
-        void validar(long long valor);
+        static void validar(long long valor);
+
+        /**
+         * @brief Multiplica o valor por (10000 + pontosBase) / 10000 com arredondamento.
+         */
+        Dinheiro escalar(long long pontosBase) const;
     public:
+        using ValorLiteral = long long;
+
+        /**
+         * @brief Verifica o intervalo permitido sem lançar exceção (constexpr).
+         * @param valor Valor em centavos.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(long long valor);
+
+        static const long long MINIMO = 1;         ///< 0,01 em centavos.
+        static const long long MAXIMO = 100000000; ///< 1.000.000,00 em centavos.
+
         /**
          * @brief Define o valor monetário a partir de um double.
          * @details Converte o valor double para centavos internamente.
@@ -144,13 +355,120 @@ class Dinheiro {
          */
         void setValor(double valor);
 
+        /**
+         * @brief Define o valor monetário a partir de texto decimal, sem arredondamentos.
+         * @details Formato aceito: dígitos, opcionalmente seguidos de ponto ou vírgula e
+         * até 2 casas decimais (ex: "100", "100.5", "100,50").
+         * @param texto Valor em reais.
+         * @throw std::invalid_argument Se o formato for inválido ou fora do intervalo.
+         */
+        void setValor(string_view texto);
+
+        /**
+         * @brief Define o valor diretamente em centavos.
+         * @param centavos Valor em centavos.
+         * @throw std::invalid_argument Se fora do intervalo permitido.
+         */
+        void setCentavos(long long centavos);
+
+        /**
+         * @brief Define o valor a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Dinheiro>& literal);
+
         /**
          * @brief Retorna o valor monetário convertido para double.
          * @return double Valor formatado em reais.
          */
         double getValor() const;
+
+        /**
+         * @brief Retorna o valor exato em centavos.
+         * @return long long Centavos.
+         */
+        long long getCentavos() const;
+
+        /**
+         * @brief Formata o valor com duas casas decimais (ex: "1234.50").
+         * @return string Texto do valor.
+         */
+        string formatar() const;
+
+        /**
+         * @brief Soma dois valores.
+         * @throw std::invalid_argument Se o resultado exceder o máximo permitido.
+         */
+        Dinheiro operator+(const Dinheiro& outro) const;
+
+        /**
+         * @brief Multiplica o valor por uma quantidade (ex: diária vezes noites).
+         * @throw std::invalid_argument Se o resultado estiver fora do intervalo.
+         */
+        Dinheiro operator*(unsigned int quantidade) const;
+
+        /**
+         * @brief Aplica um desconto percentual.
+         * @param pontosBase Desconto em pontos-base (ex: 1000 = 10%), de 0 a 10000.
+         * @throw std::invalid_argument Se o resultado estiver fora do intervalo.
+         */
+        Dinheiro aplicarDesconto(unsigned int pontosBase) const;
+
+        /**
+         * @brief Aplica um acréscimo percentual.
+         * @param pontosBase Acréscimo em pontos-base (ex: 2500 = 25%).
+         * @throw std::invalid_argument Se o resultado estiver fora do intervalo.
+         */
+        Dinheiro aplicarAcrescimo(unsigned int pontosBase) const;
+
+        bool operator==(const Dinheiro& outro) const { return valor == outro.valor; }
+        bool operator!=(const Dinheiro& outro) const { return valor != outro.valor; }
+        bool operator<(const Dinheiro& outro) const { return valor < outro.valor; }
+        bool operator>(const Dinheiro& outro) const { return valor > outro.valor; }
+        bool operator<=(const Dinheiro& outro) const { return valor <= outro.valor; }
+        bool operator>=(const Dinheiro& outro) const { return valor >= outro.valor; }
+
+        /**
+         * @brief Soma os valores de um intervalo de objetos Dinheiro.
+         * @details O total não é limitado ao máximo do domínio (ex: faturamento agregado).
+         * @return long long Total em centavos.
+         */
+        template <class Iterador>
+        static long long somar(Iterador inicio, Iterador fim);
+
+        /**
+         * @brief Soma os valores obtidos de cada elemento de um intervalo por uma projeção.
+         * @param projecao Função que recebe o elemento e retorna um Dinheiro (ex: valor da reserva).
+         * @return long long Total em centavos.
+         */
+        template <class Iterador, class Projecao>
+        static long long somar(Iterador inicio, Iterador fim, Projecao projecao);
 };
 
+inline long long Dinheiro::getCentavos() const {
+    return valor;
+}
+
+template <class Iterador>
+long long Dinheiro::somar(Iterador inicio, Iterador fim) {
+    long long total = 0;
+    for (; inicio != fim; ++inicio) total += inicio->valor;
+    return total;
+}
+
+template <class Iterador, class Projecao>
+long long Dinheiro::somar(Iterador inicio, Iterador fim, Projecao projecao) {
+    long long total = 0;
+    for (; inicio != fim; ++inicio) total += projecao(*inicio).getCentavos();
+    return total;
+}
+
+constexpr const char* Dinheiro::verificar(long long valor) {
+    if (valor < MINIMO || valor > MAXIMO) { // 1 centavo a 1 milhão de reais (em centavos)
+        return "Valor monetario fora do intervalo permitido (0,01 a 1.000.000,00).";
+    }
+    return nullptr;
+}
+
 /**
  * @class Cartao
  * @brief Domínio para representar um número de cartão de crédito.
@@ -169,6 +487,15 @@ class Cartao {
          */
         void validar(const string& valor);
     public:
+        using ValorLiteral = string_view;
+
+        /**
+         * @brief Verifica formato e dígito de Luhn sem lançar exceção (constexpr).
+         * @param valor Texto com os 16 dígitos.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(string_view valor);
+
         /**
          * @brief Define o número do cartão.
          * @param valor String contendo os 16 dígitos.
@@ -176,17 +503,52 @@ class Cartao {
          */
         void setValor(const string& valor);
 
+        /**
+         * @brief Define o valor a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Cartao>& literal);
+
         /**
          * @brief Retorna o número do cartão.
-         * @return string Número do cartão.
+         * @return const string& Número do cartão.
          */
-        string getValor() const;
+        const string& getValor() const;
 };
 
-inline string Cartao::getValor() const {
+inline const string& Cartao::getValor() const {
     return this->valor;
 }
 
+constexpr const char* Cartao::verificar(string_view valor) {
+    if(valor.size() != 16)
+        return "O numero do cartao deve conter exatamente 16 digitos.";
+
+    for(char c : valor){
+        if(!Caractere::ehDigito(c))
+            return "O cartao deve conter apenas digitos (0-9).";
+    }
+
+    // Algoritmo de Luhn
+    int soma = 0;
+    for(int i = 14; i >= 0; i--){
+        int digito = valor[i] - '0';
+
+        // Como size é 16 (par), índices pares (0, 2... 14) são os que dobram.
+        if(i % 2 == 0) {
+            digito *= 2;
+            if(digito > 9) digito -= 9;
+        }
+        soma += digito;
+    }
+
+    int digitoVerificadorCalculado = (10 - (soma % 10)) % 10;
+    int digitoVerificadorReal = valor[15] - '0';
+
+    if(digitoVerificadorCalculado != digitoVerificadorReal)
+        return "Numero do cartao invalido (falha no algoritmo de Luhn).";
+    return nullptr;
+}
+
 /**
  * @class Nome
  * @brief Domínio para nomes de pessoas ou hotéis.
@@ -206,6 +568,15 @@ class Nome {
          */
         void validar(const string& valor);
     public:
+        using ValorLiteral = string_view;
+
+        /**
+         * @brief Verifica a formatação do nome sem lançar exceção (constexpr).
+         * @param valor Texto do nome.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(string_view valor);
+
         /**
          * @brief Define o nome.
          * @param valor String do nome.
@@ -213,17 +584,53 @@ class Nome {
          */
         void setValor(const string& valor);
 
+        /**
+         * @brief Define o valor a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Nome>& literal);
+
         /**
          * @brief Retorna o nome armazenado.
-         * @return string Nome.
+         * @return const string& Nome.
          */
-        string getValor() const;
+        const string& getValor() const;
 };
 
-inline string Nome::getValor() const {
+inline const string& Nome::getValor() const {
     return this->valor;
 }
 
+constexpr const char* Nome::verificar(string_view valor) {
+    if(valor.size() < 5 || valor.size() > 20)
+        return "Nome deve conter entre 5 e 20 caracteres.";
+
+    if(valor.back() == ' ')
+        return "Ultimo caractere nao deve ser espaco em branco.";
+
+    // Verifica caractere inicial
+    if(!Caractere::ehMaiuscula(valor[0]))
+        return "Primeiro caractere deve ser letra maiuscula.";
+
+    bool espacoAnterior = false;
+    for(size_t i = 0; i < valor.size(); i++){
+        char c = valor[i];
+
+        if (c == ' ') {
+            if (espacoAnterior) return "Nao pode haver espacos seguidos.";
+            espacoAnterior = true;
+            continue;
+        }
+
+        if (espacoAnterior) {
+            if (!Caractere::ehMaiuscula(c)) return "Primeiro caractere de cada termo deve ser maiusculo.";
+            espacoAnterior = false;
+        } else {
+            if (!Caractere::ehLetra(c)) return "Nome deve conter apenas letras e espacos.";
+        }
+    }
+    return nullptr;
+}
+
 /**
  * @class Capacidade
  * @brief Gerencia a capacidade máxima de pessoas em um quarto.
@@ -240,6 +647,15 @@ class Capacidade {
          */
         void validar(unsigned short capacidade) const;
     public:
+        using ValorLiteral = unsigned short;
+
+        /**
+         * @brief Verifica se a capacidade está entre 1 e 4, sem lançar exceção (constexpr).
+         * @param capacidade Valor a ser verificado.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(unsigned short capacidade);
+
         /**
          * @brief Define a capacidade.
          * @param capacidade Valor entre 1 e 4.
@@ -247,6 +663,11 @@ class Capacidade {
          */
         void setValor(unsigned short capacidade);
 
+        /**
+         * @brief Define o valor a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Capacidade>& literal);
+
         /**
          * @brief Retorna a capacidade.
          * @return unsigned short Valor da capacidade.
@@ -258,39 +679,183 @@ inline unsigned short Capacidade::getValor() const {
     return capacidade;
 }
 
+constexpr const char* Capacidade::verificar(unsigned short capacidade) {
+    if (capacidade < 1 || capacidade > 4)
+        return "Capacidade deve ser 1, 2, 3 ou 4.";
+    return nullptr;
+}
+
+/**
+ * @class Calendario
+ * @brief Motor de calendário para o intervalo de anos aceito por Data (2000-2999).
+ *
+ * @details Cada data é identificada por um número serial: a quantidade de dias desde
+ * 01-JAN-2000. As tabelas são geradas em tempo de compilação (início de cada ano em dias
+ * e mês/dia de cada dia do ano), de modo que conversões entre data e serial, noites entre
+ * datas, soma de dias e dia da semana são calculados em tempo constante, sem laços por dia.
+ */
+class Calendario {
+    public:
+        static const unsigned short ANO_MIN = 2000;
+        static const unsigned short ANO_MAX = 2999;
+        static const int QUANTIDADE_ANOS = ANO_MAX - ANO_MIN + 1;
+
+        /// Dias da semana retornados por diaDaSemana.
+        enum DiaSemana { DOMINGO, SEGUNDA, TERCA, QUARTA, QUINTA, SEXTA, SABADO };
+
+        static constexpr bool ehBissexto(unsigned short ano) {
+            return (ano % 4 == 0 && (ano % 100 != 0 || ano % 400 == 0));
+        }
+
+        static constexpr unsigned short diasNoMes(unsigned short mes, unsigned short ano) {
+            switch (mes) {
+                case 1: case 3: case 5: case 7: case 8: case 10: case 12: return 31;
+                case 4: case 6: case 9: case 11: return 30;
+                case 2: return ehBissexto(ano) ? 29 : 28;
+                default: return 0;
+            }
+        }
+
+        /**
+         * @brief Converte uma data válida em serial.
+         * @param dia Dia (1-31).
+         * @param mes Mês (1-12).
+         * @param ano Ano (2000-2999).
+         * @return int Dias desde 01-JAN-2000.
+         */
+        static constexpr int paraSerial(unsigned short dia, unsigned short mes, unsigned short ano);
+
+        /**
+         * @brief Converte um serial de volta em dia, mês e ano.
+         * @param serial Dias desde 01-JAN-2000 (0 a ultimoSerial()).
+         */
+        static constexpr void deSerial(int serial, unsigned short& dia, unsigned short& mes, unsigned short& ano);
+
+        /**
+         * @brief Retorna o dia da semana de um serial.
+         */
+        static constexpr DiaSemana diaDaSemana(int serial) {
+            return static_cast<DiaSemana>((serial + SABADO) % 7); // 01-JAN-2000 foi um sábado
+        }
+
+        /**
+         * @brief Conta quantos dias de um intervalo caem em um dia da semana.
+         * @param serial Primeiro dia do intervalo.
+         * @param dias Quantidade de dias consecutivos.
+         * @param alvo Dia da semana procurado.
+         */
+        static constexpr int contarDiaDaSemana(int serial, int dias, DiaSemana alvo) {
+            // Cada semana completa contém exatamente um dia alvo; resta verificar o resto
+            int total = dias / 7;
+            int deslocamento = (alvo - diaDaSemana(serial) + 7) % 7;
+            if (deslocamento < dias % 7) total++;
+            return total;
+        }
+
+        /**
+         * @brief Retorna o maior serial representável (31-DEZ-2999).
+         */
+        static constexpr int ultimoSerial();
+    private:
+        struct Tabelas {
+            int inicioAno[QUANTIDADE_ANOS + 1] = {};     // Serial de 01-JAN de cada ano
+            unsigned short inicioMes[2][14] = {};      // Dia do ano em que cada mês começa [bissexto][mes]
+            unsigned char mesDoDia[2][366] = {};       // Mês de cada dia do ano [bissexto][diaDoAno]
+
+            constexpr Tabelas() {
+                for (int i = 0; i < QUANTIDADE_ANOS; i++) {
+                    inicioAno[i + 1] = inicioAno[i] + (ehBissexto(ANO_MIN + i) ? 366 : 365);
+                }
+                for (int bissexto = 0; bissexto < 2; bissexto++) {
+                    unsigned short anoReferencia = bissexto ? 2000 : 2001;
+                    for (unsigned short mes = 1; mes <= 12; mes++) {
+                        unsigned short dias = diasNoMes(mes, anoReferencia);
+                        inicioMes[bissexto][mes + 1] = inicioMes[bissexto][mes] + dias;
+                        for (unsigned short d = 0; d < dias; d++) {
+                            mesDoDia[bissexto][inicioMes[bissexto][mes] + d] = static_cast<unsigned char>(mes);
+                        }
+                    }
+                }
+            }
+        };
+
+        static const Tabelas TABELAS;
+};
+
+inline constexpr Calendario::Tabelas Calendario::TABELAS{};
+
+constexpr int Calendario::paraSerial(unsigned short dia, unsigned short mes, unsigned short ano) {
+    return TABELAS.inicioAno[ano - ANO_MIN] + TABELAS.inicioMes[ehBissexto(ano)][mes] + dia - 1;
+}
+
+constexpr void Calendario::deSerial(int serial, unsigned short& dia, unsigned short& mes, unsigned short& ano) {
+    // Estimativa pelo ano gregoriano médio (146097 dias a cada 400 anos),
+    // corrigida em no máximo um ano pela tabela
+    int indice = static_cast<int>((serial * 400LL) / 146097);
+    if (indice >= QUANTIDADE_ANOS) indice = QUANTIDADE_ANOS - 1;
+    if (TABELAS.inicioAno[indice] > serial) indice--;
+    else if (TABELAS.inicioAno[indice + 1] <= serial) indice++;
+
+    ano = static_cast<unsigned short>(ANO_MIN + indice);
+    int diaDoAno = serial - TABELAS.inicioAno[indice];
+    bool bissexto = ehBissexto(ano);
+    mes = TABELAS.mesDoDia[bissexto][diaDoAno];
+    dia = static_cast<unsigned short>(diaDoAno - TABELAS.inicioMes[bissexto][mes] + 1);
+}
+
+constexpr int Calendario::ultimoSerial() {
+    return TABELAS.inicioAno[QUANTIDADE_ANOS] - 1;
+}
+
+class Data;
+template <> class Literal<Data>;
+
 /**
  * @class Data
  * @brief Representa uma data no formato DD-MMM-AAAA.
  *
  * @details Valida dias (1-31), meses (JAN, FEV...) e anos (2000-2999),
  * considerando anos bissextos e a quantidade de dias de cada mês.
+ * Datas são ordenadas cronologicamente.
  */
 class Data {
     private:
-        unsigned short dia;
+        unsigned short dia = 0;
         string mes;
-        unsigned short ano;
+        unsigned short indiceMes = 0; // 1 (JAN) a 12 (DEZ)
+        unsigned short ano = 0;
+        int serial = 0; // Dias desde 01-JAN-2000, usado nas comparações e na aritmética
 
-        static const int ANO_MIN = 2000;
-        static const int ANO_MAX = 2999;
+        static const int ANO_MIN = Calendario::ANO_MIN;
+        static const int ANO_MAX = Calendario::ANO_MAX;
 
-        // Métodos auxiliares de validação (internos)
-        string letraMaiuscula(const string &s) const;
-        unsigned short mesParaIndice(const string &mes) const;
-        bool ehBissexto(unsigned short ano) const;
-        unsigned short diasNoMes(const string &mes, unsigned short ano) const;
-        bool mesValido(const string &mes) const;
+        static constexpr string_view NOMES_MESES[12] = {
+            "JAN", "FEV", "MAR", "ABR", "MAI", "JUN", "JUL", "AGO", "SET", "OUT", "NOV", "DEZ"
+        };
+
+        // Métodos auxiliares (internos)
+        static constexpr unsigned short mesParaIndice(string_view mes);
+        void atribuir(unsigned short dia, unsigned short indiceMes, unsigned short ano);
 
         /**
          * @brief Valida a data completa (dia, mês e ano).
          * @param dia Dia do mês.
          * @param mes Mês em formato texto (3 letras).
          * @param ano Ano com 4 dígitos.
-         * @throw std::invalid_argument ou std::out_of_range Se a data for inválida.
+         * @throw std::invalid_argument Se a data for inválida.
          */
-        void validar(unsigned short dia, const string &mes, unsigned short ano) const;
+        static void validar(unsigned short dia, string_view mes, unsigned short ano);
 
     public:
+        /**
+         * @brief Verifica a data sem lançar exceção; utilizável em tempo de compilação.
+         * @param dia Dia do mês.
+         * @param mes Mês em formato texto (3 letras, maiúsculas ou minúsculas).
+         * @param ano Ano com 4 dígitos.
+         * @return const char* Mensagem de erro, ou nullptr se a data for válida.
+         */
+        static constexpr const char* verificar(unsigned short dia, string_view mes, unsigned short ano);
+
         /**
          * @brief Define a data.
          * @param dia Dia (1-31).
@@ -300,6 +865,11 @@ class Data {
          */
         void setValor(unsigned short dia, const string &mes, unsigned short ano);
 
+        /**
+         * @brief Define a data a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Data>& literal);
+
         /**
          * @brief Retorna o dia.
          * @return unsigned short Dia.
@@ -308,20 +878,130 @@ class Data {
 
         /**
          * @brief Retorna o mês.
-         * @return string Mês (3 letras maiúsculas).
+         * @return const string& Mês (3 letras maiúsculas).
          */
-        string getMes() const;
+        const string& getMes() const;
 
         /**
          * @brief Retorna o ano.
          * @return unsigned short Ano.
          */
         unsigned short getAno() const;
+
+        /**
+         * @brief Retorna o mês como número.
+         * @return unsigned short Mês (1 = JAN a 12 = DEZ).
+         */
+        unsigned short getIndiceMes() const;
+
+        /**
+         * @brief Retorna o número serial da data (dias desde 01-JAN-2000).
+         * @return int Serial.
+         */
+        int getSerial() const;
+
+        /**
+         * @brief Define a data a partir de um número serial.
+         * @param serial Dias desde 01-JAN-2000.
+         * @throw std::invalid_argument Se o serial estiver fora do intervalo 2000-2999.
+         */
+        void setSerial(int serial);
+
+        /**
+         * @brief Calcula a quantidade de noites entre esta data e uma data posterior.
+         * @param partida Data final.
+         * @return int Noites (negativo se partida for anterior a esta data).
+         */
+        int noitesAte(const Data& partida) const;
+
+        /**
+         * @brief Retorna a data deslocada de uma quantidade de dias.
+         * @param dias Dias a somar (pode ser negativo).
+         * @throw std::invalid_argument Se o resultado sair do intervalo 2000-2999.
+         */
+        Data somarDias(int dias) const;
+
+        /**
+         * @brief Retorna o dia da semana da data.
+         */
+        Calendario::DiaSemana diaDaSemana() const;
+
+        /**
+         * @brief Retorna o primeiro dia do mês desta data.
+         * @details Calculado pelo serial; uma Data não definida vale 01-JAN-2000, como em somarDias.
+         */
+        Data primeiroDiaDoMes() const;
+
+        /**
+         * @brief Retorna o último dia do mês desta data.
+         * @details Calculado pelo serial; uma Data não definida vale 01-JAN-2000, como em somarDias.
+         */
+        Data ultimoDiaDoMes() const;
+
+        bool operator==(const Data& outra) const { return serial == outra.serial; }
+        bool operator!=(const Data& outra) const { return serial != outra.serial; }
+        bool operator<(const Data& outra) const { return serial < outra.serial; }
+        bool operator>(const Data& outra) const { return serial > outra.serial; }
+        bool operator<=(const Data& outra) const { return serial <= outra.serial; }
+        bool operator>=(const Data& outra) const { return serial >= outra.serial; }
+
+        friend struct std::hash<Data>;
 };
 
 inline unsigned short Data::getDia() const { return dia; }
-inline string Data::getMes() const { return mes; }
+inline const string& Data::getMes() const { return mes; }
 inline unsigned short Data::getAno() const { return ano; }
+inline unsigned short Data::getIndiceMes() const { return indiceMes; }
+inline int Data::getSerial() const { return serial; }
+inline int Data::noitesAte(const Data& partida) const { return partida.serial - serial; }
+inline Calendario::DiaSemana Data::diaDaSemana() const { return Calendario::diaDaSemana(serial); }
+
+constexpr unsigned short Data::mesParaIndice(string_view mes) {
+    if (mes.size() != 3) return 0;
+    for (unsigned short i = 0; i < 12; i++) {
+        const string_view nome = NOMES_MESES[i];
+        if (Caractere::paraMaiuscula(mes[0]) == nome[0] &&
+            Caractere::paraMaiuscula(mes[1]) == nome[1] &&
+            Caractere::paraMaiuscula(mes[2]) == nome[2]) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+constexpr const char* Data::verificar(unsigned short dia, string_view mes, unsigned short ano) {
+    if (ano < ANO_MIN || ano > ANO_MAX)
+        return "Ano fora do intervalo permitido (2000-2999).";
+
+    unsigned short indice = mesParaIndice(mes);
+    if (indice == 0)
+        return "Mes invalido. Use JAN, FEV, MAR, etc.";
+
+    unsigned short limite = Calendario::diasNoMes(indice, ano);
+    if (dia < 1 || dia > limite)
+        return "Dia invalido para o mes e ano informados.";
+    return nullptr;
+}
+
+/**
+ * @brief Especialização de Literal para datas, verificadas a partir de dia, mês e ano.
+ */
+template <>
+class Literal<Data> {
+    public:
+        constexpr Literal(unsigned short dia, string_view mes, unsigned short ano)
+            : dia(dia), mes(mes), ano(ano) {
+            if (const char* erro = Data::verificar(dia, mes, ano)) throw invalid_argument(erro);
+        }
+
+        constexpr unsigned short getDia() const { return dia; }
+        constexpr string_view getMes() const { return mes; }
+        constexpr unsigned short getAno() const { return ano; }
+    private:
+        unsigned short dia;
+        string_view mes;
+        unsigned short ano;
+};
 
 /**
  * @class Telefone
@@ -339,6 +1019,15 @@ class Telefone {
          */
         void validar(const string &telefone);
     public:
+        using ValorLiteral = string_view;
+
+        /**
+         * @brief Verifica o formato +DDD... sem lançar exceção (constexpr).
+         * @param telefone Texto do telefone.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(string_view telefone);
+
         /**
          * @brief Define o número de telefone.
          * @param telefone String no formato +DD...
@@ -346,17 +1035,37 @@ class Telefone {
          */
         void setValor(const string &telefone);
 
+        /**
+         * @brief Define o valor a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Telefone>& literal);
+
         /**
          * @brief Retorna o telefone.
-         * @return string Telefone.
+         * @return const string& Telefone.
          */
-        string getValor() const;
+        const string& getValor() const;
 };
 
-inline string Telefone::getValor() const {
+inline const string& Telefone::getValor() const {
     return telefone;
 }
 
+constexpr const char* Telefone::verificar(string_view telefone) {
+    if (telefone.empty() || telefone[0] != '+')
+        return "Telefone deve comecar com '+'.";
+
+    // Assumindo + e 15 digitos = 16 chars (validação do código original da equipe).
+    if (telefone.size() != 16)
+        return "Telefone deve ter formato + e 15 digitos (Total 16 chars).";
+
+    for (size_t i = 1; i < telefone.size(); i++) {
+        if (!Caractere::ehDigito(telefone[i]))
+            return "Telefone deve conter apenas digitos apos o '+'.";
+    }
+    return nullptr;
+}
+
 /**
  * @class Codigo
  * @brief Domínio para códigos de identificação únicos (PK).
@@ -375,6 +1084,15 @@ class Codigo {
          */
         void validar(const string& codigo);
     public:
+        using ValorLiteral = string_view;
+
+        /**
+         * @brief Verifica tamanho e conteúdo do código sem lançar exceção (constexpr).
+         * @param codigo Texto do código.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(string_view codigo);
+
         /**
          * @brief Define o código.
          * @param codigo String de 10 caracteres.
@@ -382,52 +1100,394 @@ class Codigo {
          */
         void setValor(const string& codigo);
 
+        /**
+         * @brief Define o valor a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Codigo>& literal);
+
         /**
          * @brief Retorna o código.
-         * @return string Código.
+         * @return const string& Código.
          */
-        string getValor() const;
+        const string& getValor() const;
+
+        bool operator==(const Codigo& outro) const { return codigo == outro.codigo; }
+        bool operator!=(const Codigo& outro) const { return codigo != outro.codigo; }
+        bool operator<(const Codigo& outro) const { return codigo < outro.codigo; }
+        bool operator>(const Codigo& outro) const { return codigo > outro.codigo; }
+        bool operator<=(const Codigo& outro) const { return codigo <= outro.codigo; }
+        bool operator>=(const Codigo& outro) const { return codigo >= outro.codigo; }
+
+        friend struct std::hash<Codigo>;
 };
 
-inline string Codigo::getValor() const {
+inline const string& Codigo::getValor() const {
     return codigo;
 }
 
+constexpr const char* Codigo::verificar(string_view codigo) {
+    if(codigo.length() != TAMANHO) {
+        return "Codigo deve ter 10 caracteres.";
+    }
+
+    for(char c : codigo) {
+        if(!Caractere::ehAlfanumerico(c)) {
+            return "Codigo deve conter apenas letras e numeros.";
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @class TabelaDominios
+ * @brief Tabela global de internamento das partes de domínio dos e-mails.
+ *
+ * @details Cada domínio distinto (em minúsculas) é armazenado uma única vez e
+ * identificado por um inteiro. O identificador 0 é reservado para o domínio vazio
+ * de um EMAIL ainda não definido. As referências retornadas por obter permanecem
+ * válidas durante toda a execução. Todas as operações são seguras entre threads.
+ *
+ * A tabela nunca remove domínios; por isso só recebe os de valores armazenados
+ * nos containers (EMAIL::internar). Valores de passagem, como os de tentativas de
+ * login, usam procurar, que não insere.
+ *
+ * obter e resumo não pegam a trava: as entradas ficam em blocos de tamanho fixo
+ * que nunca mudam de lugar (um deque não serviria, pois push_back realoca o mapa
+ * interno que operator[] lê), e um identificador só chega a quem o recebeu de
+ * internar ou procurar, ou de uma cópia do EMAIL, depois da entrada escrita.
+ * Assim o hash e a comparação de e-mails internados não disputam a trava global.
+ */
+class TabelaDominios {
+    private:
+        struct Entrada {
+            string texto;
+            size_t resumo = 0; // hash<string_view> do texto, calculado na inserção
+        };
+
+        static constexpr size_t TAMANHO_BLOCO = 1024;
+        static constexpr size_t MAXIMO_BLOCOS = 4096;
+
+        mutable shared_mutex mutex;                   // Protege indice e a criação de entradas
+        unique_ptr<Entrada[]> blocos[MAXIMO_BLOCOS];  // Criados sob a trava, nunca liberados
+        atomic<uint32_t> quantidade{0};
+        unordered_map<string_view, uint32_t> indice;  // Visões para os textos das entradas
+
+        TabelaDominios();
+        uint32_t inserir(string_view dominio); // Com a trava exclusiva
+
+        const Entrada& entrada(uint32_t id) const {
+            return blocos[id / TAMANHO_BLOCO][id % TAMANHO_BLOCO];
+        }
+    public:
+        TabelaDominios(const TabelaDominios&) = delete;
+        TabelaDominios& operator=(const TabelaDominios&) = delete;
+
+        /**
+         * @brief Retorna a tabela única do processo.
+         */
+        static TabelaDominios& instancia() {
+            static TabelaDominios tabela;
+            return tabela;
+        }
+
+        /**
+         * @brief Obtém o identificador de um domínio, inserindo-o se ainda não existir.
+         * @param dominio Domínio já validado e em minúsculas.
+         * @return uint32_t Identificador do domínio.
+         * @throw std::length_error Se a tabela estiver cheia.
+         */
+        uint32_t internar(string_view dominio);
+
+        /**
+         * @brief Obtém o identificador de um domínio sem inseri-lo.
+         * @param dominio Domínio já validado e em minúsculas.
+         * @return uint32_t Identificador do domínio, ou NAO_INTERNADO se ele não estiver na tabela.
+         */
+        uint32_t procurar(string_view dominio) const;
+
+        static constexpr uint32_t NAO_INTERNADO = UINT32_MAX;
+
+        /**
+         * @brief Recupera o texto de um domínio internado, sem trava.
+         * @param id Identificador retornado por internar.
+         * @return const string& Domínio em minúsculas.
+         */
+        const string& obter(uint32_t id) const { return entrada(id).texto; }
+
+        /**
+         * @brief Hash do texto de um domínio internado (o mesmo de hash<string_view>), sem trava.
+         */
+        size_t resumo(uint32_t id) const { return entrada(id).resumo; }
+
+        /**
+         * @brief Retorna a quantidade de domínios distintos armazenados.
+         */
+        size_t tamanho() const { return quantidade.load(memory_order_acquire); }
+};
+
 /**
  * @class EMAIL
  * @brief Domínio para endereços de e-mail.
  *
  * @details Formato padrão: parte-local@domínio.
  * Valida caracteres permitidos, posição de pontos e hífens, e tamanho máximo.
+ *
+ * O valor é armazenado em forma canônica (letras minúsculas), calculada uma única vez
+ * em setValor. A parte local é guardada no objeto. O domínio é referenciado pelo
+ * identificador da TabelaDominios quando já está nela; senão, o texto fica no próprio
+ * objeto, após a parte local, até que um container o armazene e chame internar. Assim, hóspedes do mesmo
+ * provedor compartilham o texto do domínio e a comparação de dois e-mails internados se
+ * reduz à comparação de identificadores, sem que valores de passagem (logins
+ * recusados, pesquisas) façam a tabela crescer.
+ * A ordenação é feita pela parte local e, em caso de empate, pelo texto do domínio.
  */
 class EMAIL {
     private:
-        string email;
+        string texto;                  // Parte local; seguida de "@domínio" se este não estiver internado
+        uint32_t dominio = 0;          // TabelaDominios::NAO_INTERNADO: domínio em texto
+        unsigned char tamanhoLocal = 0;
         static const int MAX_PARTE_LOCAL = 64;
         static const int MAX_DOMINIO = 255;
+
+        // Varredura SWAR (SIMD dentro de um registrador): 8 caracteres são classificados
+        // por vez em um inteiro de 64 bits, sem depender de intrínsecos de uma arquitetura.
+        static constexpr uint64_t BYTES_01 = 0x0101010101010101ULL;
+        static constexpr uint64_t BYTES_7F = 0x7F7F7F7F7F7F7F7FULL;
+        static constexpr uint64_t BYTES_80 = 0x8080808080808080ULL;
+
+        // Lê 8 bytes como inteiro little-endian (o compilador reduz a uma única leitura).
+        static constexpr uint64_t carregarBloco(const char* p) {
+            uint64_t bloco = 0;
+            for (int k = 0; k < 8; k++) bloco |= uint64_t(static_cast<unsigned char>(p[k])) << (8 * k);
+            return bloco;
+        }
+
+        // Marca com 0x80 cada byte b (ASCII) do bloco tal que m < b < n.
+        static constexpr uint64_t bytesEntre(uint64_t x, uint64_t m, uint64_t n) {
+            uint64_t baixo = x & BYTES_7F;
+            return (BYTES_01 * (127 + n) - baixo) & ~x & (baixo + BYTES_01 * (127 - m)) & BYTES_80;
+        }
+
+        static constexpr uint64_t bytesMaiusculos(uint64_t x) {
+            return bytesEntre(x, 'A' - 1, 'Z' + 1);
+        }
+
+        // Verdadeiro se os 8 bytes do bloco são letras ou dígitos ASCII.
+        static constexpr bool blocoAlfanumerico(uint64_t x) {
+            uint64_t alfanumericos = bytesEntre(x, '0' - 1, '9' + 1)
+                                   | bytesMaiusculos(x)
+                                   | bytesEntre(x, 'a' - 1, 'z' + 1);
+            return (x & BYTES_80) == 0 && alfanumericos == BYTES_80;
+        }
+
         /**
          * @brief Valida o email.
-         * @param email String do email.
+         * @param email Texto do email.
          * @throw std::invalid_argument Se o formato for inválido.
          */
-        void validar(const string& email);
+        static void validar(string_view email);
+
+        /**
+         * @brief Converte um trecho já validado para minúsculas (forma canônica), no próprio buffer.
+         * @param texto Início do trecho.
+         * @param tamanho Quantidade de caracteres.
+         */
+        static void normalizar(char* texto, size_t tamanho);
+
+        /**
+         * @brief Normaliza e armazena um email já validado.
+         */
+        void atribuir(string_view email);
     public:
+        using ValorLiteral = string_view;
+
+        /**
+         * @brief Verifica o formato do email sem realizar alocações nem lançar exceções.
+         * @details Trechos alfanuméricos são verificados 8 bytes por vez; apenas os
+         * caracteres de pontuação passam pela verificação caractere a caractere.
+         * Pode ser avaliada em tempo de compilação.
+         * @param email Texto do email.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(string_view email);
+
         /**
          * @brief Define o email.
-         * @param email String do email.
+         * @param email Texto do email (qualquer combinação de maiúsculas e minúsculas).
          * @throw std::invalid_argument Se inválido.
          */
-        void setValor(const string& email);
+        void setValor(string_view email);
+
+        /**
+         * @brief Define o email a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<EMAIL>& literal);
 
         /**
-         * @brief Retorna o email.
-         * @return string Email.
+         * @brief Retorna o email completo em forma canônica.
+         * @details Monta o texto a partir da parte local e do domínio internado, por isso
+         * retorna por valor. Para comparações e buscas, compare os objetos EMAIL diretamente.
+         * @return string Email em minúsculas.
          */
         string getValor() const;
+
+        /**
+         * @brief Retorna a parte local (antes do '@') em minúsculas.
+         * @details A visão vale enquanto o objeto não for alterado.
+         */
+        string_view getParteLocal() const;
+
+        /**
+         * @brief Retorna o domínio (após o '@') em minúsculas.
+         * @details A visão vale enquanto o objeto não for alterado.
+         */
+        string_view getDominio() const;
+
+        /**
+         * @brief Hash do domínio, igual ao de hash<string_view> sobre getDominio().
+         * @details Se o domínio estiver internado, vem pronto da TabelaDominios.
+         */
+        size_t resumoDominio() const;
+
+        /**
+         * @brief Passa a referenciar o domínio pela TabelaDominios, inserindo-o se preciso.
+         * @details Chamado pelos containers ao armazenar o valor; valores de passagem
+         * não devem ser internados, pois a tabela nunca remove domínios.
+         */
+        void internar();
+
+        /**
+         * @brief Indica se o domínio está referenciado pela TabelaDominios.
+         */
+        bool internado() const { return dominio != TabelaDominios::NAO_INTERNADO; }
+
+        bool operator==(const EMAIL& outro) const;
+        bool operator!=(const EMAIL& outro) const;
+        bool operator<(const EMAIL& outro) const;
+        bool operator>(const EMAIL& outro) const { return outro < *this; }
+        bool operator<=(const EMAIL& outro) const { return !(outro < *this); }
+        bool operator>=(const EMAIL& outro) const { return !(*this < outro); }
+
+        friend struct std::hash<EMAIL>;
 };
 
+constexpr const char* EMAIL::verificar(string_view email) {
+    // Verifica estrutura básica
+    size_t posArroba = email.find('@');
+    if(posArroba == string_view::npos) {
+        return "Email deve conter '@'.";
+    }
+
+    string_view parte_local = email.substr(0, posArroba);
+    string_view dominio = email.substr(posArroba + 1);
+
+    if(parte_local.length() > MAX_PARTE_LOCAL) return "Parte local muito longa.";
+    if(dominio.length() > MAX_DOMINIO) return "Dominio muito longo.";
+
+    // Validação Parte Local
+    // Pode conter letra, digito, ponto ou hifen. Não pode iniciar/terminar com ponto/hifen.
+    if(parte_local.empty()) return "Parte local vazia.";
+
+    if(parte_local.front() == '.' || parte_local.front() == '-')
+        return "Parte local nao pode iniciar com ponto ou hifen.";
+    if(parte_local.back() == '.' || parte_local.back() == '-')
+        return "Parte local nao pode terminar com ponto ou hifen.";
+
+    bool anteriorPontoOuHifen = false;
+    size_t i = 0;
+    while(i < parte_local.size()) {
+        // Caso comum: bloco inteiro alfanumérico, aceito de uma vez
+        if(i + 8 <= parte_local.size() && blocoAlfanumerico(carregarBloco(parte_local.data() + i))) {
+            anteriorPontoOuHifen = false;
+            i += 8;
+            continue;
+        }
+
+        char c = parte_local[i++];
+        if (c == '.' || c == '-') {
+            if(anteriorPontoOuHifen) return "Ponto ou hifen nao podem ser consecutivos.";
+            anteriorPontoOuHifen = true;
+        } else if (Caractere::ehAlfanumerico(c)) {
+            anteriorPontoOuHifen = false;
+        } else {
+            return "Caractere invalido na parte local do email.";
+        }
+    }
+
+    // Validação Domínio
+    // Partes separadas por ponto. Não hifen inicio/fim.
+    if(dominio.empty()) return "Dominio vazio.";
+
+    if(dominio.front() == '-') return "Dominio nao pode iniciar com hifen.";
+    if(dominio.back() == '-') return "Dominio nao pode terminar com hifen.";
+
+    // O domínio é composto por uma ou mais partes separadas por ponto ("com", "com.br"),
+    // mas não pode iniciar ou terminar com ponto.
+    if(dominio.front() == '.' || dominio.back() == '.')
+        return "Dominio nao pode iniciar ou terminar com ponto.";
+
+    anteriorPontoOuHifen = false;
+    i = 0;
+    while(i < dominio.size()) {
+        if(i + 8 <= dominio.size() && blocoAlfanumerico(carregarBloco(dominio.data() + i))) {
+            anteriorPontoOuHifen = false;
+            i += 8;
+            continue;
+        }
+
+        char c = dominio[i++];
+        if (c == '.') {
+            if(anteriorPontoOuHifen) return "Pontos nao podem ser consecutivos no dominio.";
+            anteriorPontoOuHifen = true;
+        } else if (c == '-') {
+             // Hifen no meio é ok: o PDF só proíbe iniciar ou terminar com hifen.
+        } else if (!Caractere::ehAlfanumerico(c)) {
+             return "Caractere invalido no dominio.";
+        }
+
+        if (c != '.') anteriorPontoOuHifen = false;
+    }
+    return nullptr;
+}
+
 inline string EMAIL::getValor() const {
-    return email;
+    if (!internado()) return texto; // Já contém o domínio
+    const string& textoDominio = TabelaDominios::instancia().obter(dominio);
+    string valor;
+    valor.reserve(texto.size() + 1 + textoDominio.size());
+    valor.append(texto).append(1, '@').append(textoDominio);
+    return valor;
+}
+
+inline string_view EMAIL::getParteLocal() const {
+    return string_view(texto.data(), tamanhoLocal);
+}
+
+inline string_view EMAIL::getDominio() const {
+    if (!internado()) return string_view(texto).substr(tamanhoLocal + 1u);
+    return TabelaDominios::instancia().obter(dominio);
+}
+
+inline size_t EMAIL::resumoDominio() const {
+    if (!internado()) return hash<string_view>()(getDominio());
+    return TabelaDominios::instancia().resumo(dominio);
+}
+
+inline bool EMAIL::operator==(const EMAIL& outro) const {
+    if (getParteLocal() != outro.getParteLocal()) return false;
+    if (internado() && outro.internado()) return dominio == outro.dominio;
+    return getDominio() == outro.getDominio();
+}
+
+inline bool EMAIL::operator!=(const EMAIL& outro) const {
+    return !(*this == outro);
+}
+
+inline bool EMAIL::operator<(const EMAIL& outro) const {
+    int ordem = getParteLocal().compare(outro.getParteLocal());
+    if (ordem != 0) return ordem < 0;
+    if (internado() && dominio == outro.dominio) return false;
+    return getDominio() < outro.getDominio();
 }
 
 /**
@@ -446,6 +1506,15 @@ class Ramal {
          */
         void validar(unsigned short ramal);
     public:
+        using ValorLiteral = unsigned short;
+
+        /**
+         * @brief Verifica se o ramal está entre 0 e 50, sem lançar exceção (constexpr).
+         * @param ramal Valor a ser verificado.
+         * @return const char* Mensagem de erro, ou nullptr se o valor for válido.
+         */
+        static constexpr const char* verificar(unsigned short ramal);
+
         /**
          * @brief Define o número do ramal.
          * @param ramal Inteiro entre 0 e 50.
@@ -453,6 +1522,11 @@ class Ramal {
          */
         void setValor(unsigned short ramal);
 
+        /**
+         * @brief Define o valor a partir de um Literal verificado na compilação, sem revalidar.
+         */
+        void setValor(const Literal<Ramal>& literal);
+
         /**
          * @brief Retorna o ramal.
          * @return unsigned short Ramal.
@@ -464,4 +1538,51 @@ inline unsigned short Ramal::getValor() const {
     return ramal;
 }
 
+constexpr const char* Ramal::verificar(unsigned short ramal) {
+    if(ramal > 50) { // Como é unsigned, < 0 não precisa checar
+        return "Ramal deve estar entre 0 e 50.";
+    }
+    return nullptr;
+}
+
+// ====================================================================
+// HASH DOS DOMÍNIOS USADOS COMO CHAVE
+// ====================================================================
+// Permitem usar os domínios diretamente como chave de unordered_map/unordered_set,
+// calculando o hash sobre os dados armazenados, sem cópias temporárias.
+
+namespace std {
+
+template <>
+struct hash<Numero> {
+    size_t operator()(const Numero& numero) const noexcept {
+        return hash<int>()(numero.getValor());
+    }
+};
+
+template <>
+struct hash<Data> {
+    size_t operator()(const Data& data) const noexcept {
+        return hash<int>()(data.serial);
+    }
+};
+
+template <>
+struct hash<Codigo> {
+    size_t operator()(const Codigo& codigo) const noexcept {
+        return hash<string_view>()(codigo.codigo);
+    }
+};
+
+template <>
+struct hash<EMAIL> {
+    size_t operator()(const EMAIL& email) const noexcept {
+        // Pelo texto do domínio: um valor internado e um de passagem iguais têm o mesmo hash
+        size_t h = hash<string_view>()(email.getParteLocal());
+        return h ^ (email.resumoDominio() + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+    }
+};
+
+} // namespace std
+
 #endif // DOMINIOS_HPP_INCLUDED
@@ -3,9 +3,44 @@
 
 #include "domains.hpp"
 #include <string>
+#include <utility>
 
 using namespace std;
 
+// ====================================================================
+// CONTROLE DE VERSÃO (Concorrência otimista)
+// ====================================================================
+
+/**
+ * @class Versionado
+ * @brief Base das entidades cujas atualizações podem exigir uma versão esperada.
+ *
+ * @details A versão é mantida pelo container: vale 1 na inclusão e cresce a
+ * cada atualização. Quem lê a entidade guarda a versão lida e a informa ao
+ * atualizar; se outra atualização tiver ocorrido nesse meio-tempo, as versões
+ * diferem e a atualização é recusada com ResultadoAtualizacao::CONFLITO, em vez
+ * de sobrescrever a alteração alheia. Nenhuma trava fica retida entre a
+ * leitura e a atualização.
+ */
+class Versionado {
+    private:
+        unsigned long long versao = 0; // 0 = ainda não armazenada
+    public:
+        void setVersao(unsigned long long novaVersao) { this->versao = novaVersao; }
+        unsigned long long getVersao() const { return versao; }
+};
+
+/**
+ * @enum ResultadoAtualizacao
+ * @brief Resultado de uma atualização com versão esperada.
+ */
+enum class ResultadoAtualizacao {
+    ATUALIZADO,
+    CONFLITO,       ///< A versão armazenada difere da esperada; nada foi alterado.
+    NAO_ENCONTRADO,
+    RECUSADO        ///< Regra de negócio violada (ex.: chave estrangeira inexistente).
+};
+
 // ====================================================================
 // HIERARQUIA DE PESSOAS
 // ====================================================================
@@ -30,6 +65,11 @@ class Pessoa {
          */
         void setNome(const Nome& novoNome);
 
+        /**
+         * @brief Versão de setNome que move o objeto recebido, sem cópia.
+         */
+        void setNome(Nome&& novoNome);
+
         /**
          * @brief Atribui o EMAIL da Pessoa.
          * @details O Email atua como identificador único (Chave Primária).
@@ -37,24 +77,41 @@ class Pessoa {
          */
         void setEmail(const EMAIL& novoEmail);
 
+        /**
+         * @brief Versão de setEmail que move o objeto recebido, sem cópia.
+         */
+        void setEmail(EMAIL&& novoEmail);
+
+        /**
+         * @brief Interna o domínio do EMAIL no próprio objeto (ver EMAIL::internar).
+         * @details Usado pelos containers ao armazenar a pessoa. Atribuir uma cópia
+         * internada por setEmail manteria o buffer antigo do texto, já que a string
+         * movida cabe no buffer interno.
+         */
+        void internarEmail();
+
         /**
          * @brief Recupera o Nome da Pessoa.
          * @return Objeto Nome contendo o nome armazenado.
          */
-        Nome getNome() const;
+        const Nome& getNome() const;
 
         /**
          * @brief Recupera o EMAIL da Pessoa.
          * @return Objeto EMAIL contendo o endereço de email armazenado.
          */
-        EMAIL getEmail() const;
+        const EMAIL& getEmail() const;
 };
 
 inline void Pessoa::setNome(const Nome& novoNome) {
     this->nome = novoNome;
 }
 
-inline Nome Pessoa::getNome() const {
+inline void Pessoa::setNome(Nome&& novoNome) {
+    this->nome = std::move(novoNome);
+}
+
+inline const Nome& Pessoa::getNome() const {
     return nome;
 }
 
@@ -62,7 +119,15 @@ inline void Pessoa::setEmail(const EMAIL& novoEmail) {
     this->email = novoEmail;
 }
 
-inline EMAIL Pessoa::getEmail() const {
+inline void Pessoa::setEmail(EMAIL&& novoEmail) {
+    this->email = std::move(novoEmail);
+}
+
+inline void Pessoa::internarEmail() {
+    this->email.internar();
+}
+
+inline const EMAIL& Pessoa::getEmail() const {
     return email;
 }
 
@@ -94,24 +159,29 @@ class Gerente : public Pessoa {
          */
         void setSenha(const Senha& novaSenha);
 
+        /**
+         * @brief Versão de setSenha que move o objeto recebido, sem cópia.
+         */
+        void setSenha(Senha&& novaSenha);
+
         /**
          * @brief Recupera o Ramal do Gerente.
          * @return Objeto Ramal.
          */
-        Ramal getRamal() const;
+        const Ramal& getRamal() const;
 
         /**
          * @brief Recupera a Senha do Gerente.
          * @return Objeto Senha.
          */
-        Senha getSenha() const;
+        const Senha& getSenha() const;
 };
 
 inline void Gerente::setRamal(const Ramal& novoRamal) {
     this->ramal = novoRamal;
 }
 
-inline Ramal Gerente::getRamal() const {
+inline const Ramal& Gerente::getRamal() const {
     return ramal;
 }
 
@@ -119,7 +189,11 @@ inline void Gerente::setSenha(const Senha& novaSenha) {
     this->senha = novaSenha;
 }
 
-inline Senha Gerente::getSenha() const{
+inline void Gerente::setSenha(Senha&& novaSenha) {
+    this->senha = std::move(novaSenha);
+}
+
+inline const Senha& Gerente::getSenha() const {
     return senha;
 }
 
@@ -134,7 +208,7 @@ inline Senha Gerente::getSenha() const{
  * - Endereço: Localização residencial do hóspede.
  * - Cartão: Dados de pagamento.
  */
-class Hospede : public Pessoa {
+class Hospede : public Pessoa, public Versionado {
     private:
         Endereco endereco;
         Cartao cartao;
@@ -145,30 +219,44 @@ class Hospede : public Pessoa {
          */
         void setEndereco(const Endereco& novoEndereco);
 
+        /**
+         * @brief Versão de setEndereco que move o objeto recebido, sem cópia.
+         */
+        void setEndereco(Endereco&& novoEndereco);
+
         /**
          * @brief Define os dados do Cartão de Crédito do Hóspede.
          * @param novoCartao Objeto da classe de domínio Cartao.
          */
         void setCartao(const Cartao& novoCartao);
 
+        /**
+         * @brief Versão de setCartao que move o objeto recebido, sem cópia.
+         */
+        void setCartao(Cartao&& novoCartao);
+
         /**
          * @brief Recupera o Endereço do Hóspede.
          * @return Objeto Endereco.
          */
-        Endereco getEndereco() const;
+        const Endereco& getEndereco() const;
 
         /**
          * @brief Recupera os dados do Cartão do Hóspede.
          * @return Objeto Cartao.
          */
-        Cartao getCartao() const;
+        const Cartao& getCartao() const;
 };
 
 inline void Hospede::setEndereco(const Endereco& novoEndereco) {
     this->endereco = novoEndereco;
 }
 
-inline Endereco Hospede::getEndereco() const {
+inline void Hospede::setEndereco(Endereco&& novoEndereco) {
+    this->endereco = std::move(novoEndereco);
+}
+
+inline const Endereco& Hospede::getEndereco() const {
     return endereco;
 }
 
@@ -176,7 +264,11 @@ inline void Hospede::setCartao(const Cartao& novoCartao) {
     this->cartao = novoCartao;
 }
 
-inline Cartao Hospede::getCartao() const {
+inline void Hospede::setCartao(Cartao&& novoCartao) {
+    this->cartao = std::move(novoCartao);
+}
+
+inline const Cartao& Hospede::getCartao() const {
     return cartao;
 }
 
@@ -191,7 +283,7 @@ inline Cartao Hospede::getCartao() const {
  * @details Agrega as informações de identificação e contato do estabelecimento.
  * A chave primária (PK) é o Código do hotel.
  */
-class Hotel {
+class Hotel : public Versionado {
     private:
         Nome nome;
         Endereco endereco;
@@ -204,54 +296,78 @@ class Hotel {
          */
         void setNome(const Nome& novoNome);
 
+        /**
+         * @brief Versão de setNome que move o objeto recebido, sem cópia.
+         */
+        void setNome(Nome&& novoNome);
+
         /**
          * @brief Define o Endereço físico do Hotel.
          * @param novoEndereco Objeto da classe de domínio Endereco.
          */
         void setEndereco(const Endereco& novoEndereco);
 
+        /**
+         * @brief Versão de setEndereco que move o objeto recebido, sem cópia.
+         */
+        void setEndereco(Endereco&& novoEndereco);
+
         /**
          * @brief Define o Telefone de contato do Hotel.
          * @param novoTelefone Objeto da classe de domínio Telefone.
          */
         void setTelefone(const Telefone& novoTelefone);
 
+        /**
+         * @brief Versão de setTelefone que move o objeto recebido, sem cópia.
+         */
+        void setTelefone(Telefone&& novoTelefone);
+
         /**
          * @brief Define o Código identificador único do Hotel.
          * @param novoCodigo Objeto da classe de domínio Codigo.
          */
         void setCodigo(const Codigo& novoCodigo);
 
+        /**
+         * @brief Versão de setCodigo que move o objeto recebido, sem cópia.
+         */
+        void setCodigo(Codigo&& novoCodigo);
+
         /**
          * @brief Recupera o Nome do Hotel.
          * @return Objeto Nome.
          */
-        Nome getNome() const;
+        const Nome& getNome() const;
 
         /**
          * @brief Recupera o Endereço do Hotel.
          * @return Objeto Endereco.
          */
-        Endereco getEndereco() const;
+        const Endereco& getEndereco() const;
 
         /**
          * @brief Recupera o Telefone do Hotel.
          * @return Objeto Telefone.
          */
-        Telefone getTelefone() const;
+        const Telefone& getTelefone() const;
 
         /**
          * @brief Recupera o Código identificador do Hotel.
          * @return Objeto Codigo.
          */
-        Codigo getCodigo() const;
+        const Codigo& getCodigo() const;
 };
 
 inline void Hotel::setNome(const Nome& novoNome) {
     this->nome = novoNome;
 }
 
-inline Nome Hotel::getNome() const {
+inline void Hotel::setNome(Nome&& novoNome) {
+    this->nome = std::move(novoNome);
+}
+
+inline const Nome& Hotel::getNome() const {
     return nome;
 }
 
@@ -259,7 +375,11 @@ inline void Hotel::setEndereco(const Endereco& novoEndereco) {
     this->endereco = novoEndereco;
 }
 
-inline Endereco Hotel::getEndereco() const {
+inline void Hotel::setEndereco(Endereco&& novoEndereco) {
+    this->endereco = std::move(novoEndereco);
+}
+
+inline const Endereco& Hotel::getEndereco() const {
     return endereco;
 }
 
@@ -267,7 +387,11 @@ inline void Hotel::setTelefone(const Telefone& novoTelefone) {
     this->telefone = novoTelefone;
 }
 
-inline Telefone Hotel::getTelefone() const {
+inline void Hotel::setTelefone(Telefone&& novoTelefone) {
+    this->telefone = std::move(novoTelefone);
+}
+
+inline const Telefone& Hotel::getTelefone() const {
     return telefone;
 }
 
@@ -275,7 +399,11 @@ inline void Hotel::setCodigo(const Codigo& novoCodigo) {
     this->codigo = novoCodigo;
 }
 
-inline Codigo Hotel::getCodigo() const {
+inline void Hotel::setCodigo(Codigo&& novoCodigo) {
+    this->codigo = std::move(novoCodigo);
+}
+
+inline const Codigo& Hotel::getCodigo() const {
     return codigo;
 }
 
@@ -284,11 +412,13 @@ inline Codigo Hotel::getCodigo() const {
  * @brief Entidade que representa uma unidade de acomodação (Quarto).
  *
  * @details Contém as características físicas e financeiras do quarto.
- * O Número é a chave primária (PK) no contexto de um hotel específico.
+ * O Número é a chave primária (PK) no contexto de um hotel específico; o Código
+ * identifica o hotel ao qual o quarto pertence.
  */
-class Quarto {
+class Quarto : public Versionado {
     private:
         Numero numero;
+        Codigo hotel;
         Capacidade capacidade;
         Dinheiro diaria;
         Ramal ramal;
@@ -299,6 +429,12 @@ class Quarto {
          */
         void setNumero(const Numero& novoNumero);
 
+        /**
+         * @brief Define o Hotel ao qual o quarto pertence.
+         * @param novoHotel Código (PK) do hotel.
+         */
+        void setHotel(const Codigo& novoHotel);
+
         /**
          * @brief Define a Capacidade máxima de hóspedes.
          * @param novaCapacidade Objeto da classe de domínio Capacidade.
@@ -321,40 +457,54 @@ class Quarto {
          * @brief Recupera o Número do Quarto.
          * @return Objeto Numero.
          */
-        Numero getNumero() const;
+        const Numero& getNumero() const;
+
+        /**
+         * @brief Recupera o Código do hotel do Quarto.
+         * @return Objeto Codigo.
+         */
+        const Codigo& getHotel() const;
 
         /**
          * @brief Recupera a Capacidade do Quarto.
          * @return Objeto Capacidade.
          */
-        Capacidade getCapacidade() const;
+        const Capacidade& getCapacidade() const;
 
         /**
          * @brief Recupera o valor da Diária.
          * @return Objeto Dinheiro.
          */
-        Dinheiro getDiaria() const;
+        const Dinheiro& getDiaria() const;
 
         /**
          * @brief Recupera o Ramal do Quarto.
          * @return Objeto Ramal.
          */
-        Ramal getRamal() const;
+        const Ramal& getRamal() const;
 };
 
 inline void Quarto::setNumero(const Numero& novoNumero) {
     this->numero = novoNumero;
 }
 
-inline Numero Quarto::getNumero() const {
+inline const Numero& Quarto::getNumero() const {
     return numero;
 }
 
+inline void Quarto::setHotel(const Codigo& novoHotel) {
+    this->hotel = novoHotel;
+}
+
+inline const Codigo& Quarto::getHotel() const {
+    return hotel;
+}
+
 inline void Quarto::setCapacidade(const Capacidade& novaCapacidade) {
     this->capacidade = novaCapacidade;
 }
 
-inline Capacidade Quarto::getCapacidade() const {
+inline const Capacidade& Quarto::getCapacidade() const {
     return capacidade;
 }
 
@@ -362,7 +512,7 @@ inline void Quarto::setDiaria(const Dinheiro& novaDiaria) {
     this->diaria = novaDiaria;
 }
 
-inline Dinheiro Quarto::getDiaria() const {
+inline const Dinheiro& Quarto::getDiaria() const {
     return diaria;
 }
 
@@ -370,7 +520,7 @@ inline void Quarto::setRamal(const Ramal& novoRamal) {
     this->ramal = novoRamal;
 }
 
-inline Ramal Quarto::getRamal() const {
+inline const Ramal& Quarto::getRamal() const {
     return ramal;
 }
 
@@ -379,14 +529,16 @@ inline Ramal Quarto::getRamal() const {
  * @brief Entidade que representa o contrato de hospedagem (Reserva).
  *
  * @details Agrega as informações temporais e financeiras da estadia.
- * O Código é a chave primária (PK) única da reserva.
+ * O Código é a chave primária (PK) única da reserva. O Número identifica o quarto
+ * reservado; a estadia ocupa as noites de chegada (inclusive) até partida (exclusive).
  */
-class Reserva {
+class Reserva : public Versionado {
     private:
         Data chegada;
         Data partida;
         Dinheiro valor;
         Codigo codigo;
+        Numero quarto;
     public:
         /**
          * @brief Define a Data de Check-in (Chegada).
@@ -394,12 +546,22 @@ class Reserva {
          */
         void setChegada(const Data& novaChegada);
 
+        /**
+         * @brief Versão de setChegada que move o objeto recebido, sem cópia.
+         */
+        void setChegada(Data&& novaChegada);
+
         /**
          * @brief Define a Data de Check-out (Partida).
          * @param novaPartida Objeto da classe de domínio Data.
          */
         void setPartida(const Data& novaPartida);
 
+        /**
+         * @brief Versão de setPartida que move o objeto recebido, sem cópia.
+         */
+        void setPartida(Data&& novaPartida);
+
         /**
          * @brief Define o Valor total da reserva.
          * @param novoValor Objeto da classe de domínio Dinheiro.
@@ -412,36 +574,57 @@ class Reserva {
          */
         void setCodigo(const Codigo& novoCodigo);
 
+        /**
+         * @brief Versão de setCodigo que move o objeto recebido, sem cópia.
+         */
+        void setCodigo(Codigo&& novoCodigo);
+
+        /**
+         * @brief Define o Quarto reservado.
+         * @param novoQuarto Número (PK) do quarto.
+         */
+        void setQuarto(const Numero& novoQuarto);
+
         /**
          * @brief Recupera a Data de Chegada.
          * @return Objeto Data.
          */
-        Data getChegada() const;
+        const Data& getChegada() const;
 
         /**
          * @brief Recupera a Data de Partida.
          * @return Objeto Data.
          */
-        Data getPartida() const;
+        const Data& getPartida() const;
 
         /**
          * @brief Recupera o Valor total.
          * @return Objeto Dinheiro.
          */
-        Dinheiro getValor() const;
+        const Dinheiro& getValor() const;
 
         /**
          * @brief Recupera o Código da reserva.
          * @return Objeto Codigo.
          */
-        Codigo getCodigo() const;
+        const Codigo& getCodigo() const;
+
+        /**
+         * @brief Recupera o Número do quarto reservado.
+         * @return Objeto Numero.
+         */
+        const Numero& getQuarto() const;
 };
 
 inline void Reserva::setChegada(const Data& novaChegada) {
     this->chegada = novaChegada;
 }
 
-inline Data Reserva::getChegada() const {
+inline void Reserva::setChegada(Data&& novaChegada) {
+    this->chegada = std::move(novaChegada);
+}
+
+inline const Data& Reserva::getChegada() const {
     return chegada;
 }
 
@@ -449,7 +632,11 @@ inline void Reserva::setPartida(const Data& novaPartida) {
     this->partida = novaPartida;
 }
 
-inline Data Reserva::getPartida() const {
+inline void Reserva::setPartida(Data&& novaPartida) {
+    this->partida = std::move(novaPartida);
+}
+
+inline const Data& Reserva::getPartida() const {
     return partida;
 }
 
@@ -457,7 +644,7 @@ inline void Reserva::setValor(const Dinheiro& novoValor) {
     this->valor = novoValor;
 }
 
-inline Dinheiro Reserva::getValor() const {
+inline const Dinheiro& Reserva::getValor() const {
     return valor;
 }
 
@@ -465,8 +652,20 @@ inline void Reserva::setCodigo(const Codigo& novoCodigo) {
     this->codigo = novoCodigo;
 }
 
-inline Codigo Reserva::getCodigo() const {
+inline void Reserva::setCodigo(Codigo&& novoCodigo) {
+    this->codigo = std::move(novoCodigo);
+}
+
+inline const Codigo& Reserva::getCodigo() const {
     return codigo;
 }
 
+inline void Reserva::setQuarto(const Numero& novoQuarto) {
+    this->quarto = novoQuarto;
+}
+
+inline const Numero& Reserva::getQuarto() const {
+    return quarto;
+}
+
 #endif // ENTIDADES_HPP_INCLUDED
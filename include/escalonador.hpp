@@ -0,0 +1,144 @@
+#ifndef ESCALONADOR_HPP_INCLUDED
+#define ESCALONADOR_HPP_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// ====================================================================
+// MÓDULO DE EXECUÇÃO (Pool de threads com roubo de tarefas)
+// ====================================================================
+
+/**
+ * @enum Prioridade
+ * @brief Ordem de atendimento das tarefas: uma tarefa só é pega se não houver
+ * outra de prioridade maior em nenhuma fila.
+ */
+enum class Prioridade {
+    ALTA,
+    NORMAL,
+    BAIXA   ///< Varreduras e relatórios, que não devem atrasar operações pontuais.
+};
+
+/**
+ * @enum ModoEncerramento
+ * @brief O que fazer com as tarefas ainda na fila ao encerrar o Escalonador.
+ */
+enum class ModoEncerramento {
+    CONCLUIR,  ///< Executa todas antes de parar.
+    DESCARTAR  ///< Descarta as que não começaram; os futuros delas recebem std::future_error (broken_promise).
+};
+
+/**
+ * @struct EstatisticasEscalonador
+ * @brief Contadores acumulados desde a criação do Escalonador.
+ */
+struct EstatisticasEscalonador {
+    size_t executadas = 0;
+    size_t roubadas = 0;     ///< Executadas por um trabalhador diferente do que as recebeu.
+    size_t descartadas = 0;
+};
+
+/**
+ * @class Escalonador
+ * @brief Pool de threads com uma fila por trabalhador, roubo de tarefas e prioridades.
+ *
+ * @details Cada trabalhador tem uma fila por prioridade e a consome em ordem
+ * de chegada; quando ela esvazia, rouba as tarefas mais antigas das filas dos
+ * outros. A ordem de chegada (e não a pilha, comum em pools de computação)
+ * evita que pedidos antigos fiquem esperando atrás de uma rajada de novos.
+ * Tarefas submetidas por um trabalhador vão para a fila dele; as submetidas de
+ * fora são distribuídas em rodízio. Trabalhadores sem tarefas dormem em uma
+ * variável de condição.
+ *
+ * Após encerrar(), novas submissões de fora do pool são recusadas; as feitas
+ * pelas próprias tarefas continuam aceitas até o pool parar.
+ */
+class Escalonador {
+private:
+    static constexpr size_t NIVEIS = 3; // Um por Prioridade
+
+    struct Fila {
+        mutex trava;
+        deque<function<void()>> tarefas[NIVEIS];
+    };
+
+    vector<unique_ptr<Fila>> filas; // Uma por trabalhador
+    vector<thread> trabalhadores;
+    atomic<size_t> pendentes{0};
+    atomic<size_t> proximaFila{0};
+    atomic<size_t> executadas{0};
+    atomic<size_t> roubadas{0};
+    atomic<size_t> descartadas{0};
+    bool encerrando = false;        // Protegido por travaSono
+    mutex travaSono;
+    condition_variable acordar;
+    mutex travaEncerramento;        // Serializa chamadas a encerrar()
+
+    void executar(size_t indice);
+    bool obterTarefa(size_t indice, function<void()>& tarefa);
+    void enfileirar(function<void()> tarefa, Prioridade prioridade);
+
+public:
+    /**
+     * @param quantidadeThreads Trabalhadores (0 = um por núcleo).
+     */
+    explicit Escalonador(size_t quantidadeThreads = 0);
+
+    /**
+     * @brief Encerra concluindo as pendentes (ModoEncerramento::CONCLUIR).
+     */
+    ~Escalonador();
+
+    Escalonador(const Escalonador&) = delete;
+    Escalonador& operator=(const Escalonador&) = delete;
+
+    /**
+     * @brief Agenda uma função para execução em algum trabalhador.
+     * @return Futuro com o resultado da função (ou a exceção que ela lançar).
+     * @throw std::runtime_error Se o escalonador já estiver encerrado.
+     */
+    template <typename Funcao>
+    future<typename result_of<Funcao()>::type> submeter(Funcao funcao,
+                                                         Prioridade prioridade = Prioridade::NORMAL);
+
+    /**
+     * @brief Executa funcao(0) ... funcao(quantidade - 1) em paralelo e espera todas.
+     * @details A thread chamadora também executa índices, então a chamada pode
+     * ser feita de dentro de uma tarefa do próprio pool sem risco de bloqueá-lo.
+     * @throw A primeira exceção lançada por funcao, depois de todas terminarem.
+     */
+    void paraCada(size_t quantidade, const function<void(size_t)>& funcao,
+                  Prioridade prioridade = Prioridade::NORMAL);
+
+    /**
+     * @brief Para de aceitar tarefas externas e espera os trabalhadores terminarem.
+     * @details Chamadas repetidas não têm efeito. Não deve ser chamado de dentro de uma tarefa.
+     */
+    void encerrar(ModoEncerramento modo = ModoEncerramento::CONCLUIR);
+
+    EstatisticasEscalonador getEstatisticas() const;
+    size_t getQuantidadeThreads() const { return filas.size(); }
+};
+
+template <typename Funcao>
+future<typename result_of<Funcao()>::type> Escalonador::submeter(Funcao funcao, Prioridade prioridade) {
+    using Resultado = typename result_of<Funcao()>::type;
+    // packaged_task não é copiável; o shared_ptr permite guardá-la em std::function
+    auto tarefa = make_shared<packaged_task<Resultado()>>(std::move(funcao));
+    future<Resultado> resultado = tarefa->get_future();
+    enfileirar([tarefa] { (*tarefa)(); }, prioridade);
+    return resultado;
+}
+
+#endif // ESCALONADOR_HPP_INCLUDED
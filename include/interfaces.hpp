@@ -3,7 +3,12 @@
 
 #include "entities.hpp"
 #include "domains.hpp"
+#include <functional>
+#include <future>
 #include <list>
+#include <memory>
+#include <string>
+#include <vector>
 
 using namespace std;
 
@@ -26,9 +31,79 @@ public:
      * @return true se as credenciais forem válidas, false caso contrário.
      */
     virtual bool autenticar(const EMAIL& email, const Senha& senha) = 0;
+
+    /**
+     * @brief Autentica um usuário informando a origem da requisição.
+     * @param origem Identificação da origem (ex.: endereço IP); vazia se desconhecida.
+     * @return true se as credenciais forem válidas, false caso contrário.
+     */
+    virtual bool autenticar(const EMAIL& email, const Senha& senha, const string& origem) = 0;
+
+    /**
+     * @brief Inicia a autenticação sem esperar pela conferência da senha.
+     * @param aoConcluir Recebe, na thread que conferiu a senha, o resultado e a
+     * exceção da conferência (nula se ela terminou); deve ser breve e não lançar.
+     * @throw std::runtime_error Se a tentativa for recusada antes da conferência
+     * (email ou origem bloqueados, serviço sobrecarregado).
+     */
+    virtual void autenticarAssincrono(const EMAIL& email, const Senha& senha, const string& origem,
+                                      function<void(bool, exception_ptr)> aoConcluir) = 0;
+
     virtual ~ISAutenticacao() {}
 };
 
+/**
+ * @class ISSessao
+ * @brief Interface para o serviço de sessões de gerentes autenticados.
+ *
+ * @details Após um login bem-sucedido, o gerente recebe um token opaco que
+ * identifica a sessão nas requisições seguintes, sem repetir a autenticação.
+ */
+class ISSessao {
+public:
+    /**
+     * @brief Autentica o gerente e abre uma nova sessão.
+     * @param email Email do gerente.
+     * @param senha Senha do gerente.
+     * @param origem Origem da requisição (ex.: endereço IP), repassada ao limite
+     * de tentativas por origem; vazia se desconhecida.
+     * @return Token da sessão, ou string vazia se as credenciais forem inválidas.
+     * @throw std::runtime_error Se o email ou a origem estiverem temporariamente bloqueados.
+     */
+    virtual string abrirSessao(const EMAIL& email, const Senha& senha, const string& origem) = 0;
+
+    /**
+     * @brief Versão de abrirSessao que devolve o futuro sem ocupar a thread chamadora.
+     * @return Futuro com o token, string vazia para credenciais inválidas, ou a
+     * exceção que recusou a tentativa.
+     */
+    virtual future<string> abrirSessaoAssincrona(const EMAIL& email, const Senha& senha, const string& origem) = 0;
+
+    /**
+     * @brief Verifica se o token pertence a uma sessão ativa, renovando o prazo de inatividade.
+     * @param token Token recebido em abrirSessao.
+     * @param email Se não for nulo, recebe o email do dono da sessão.
+     * @return true se a sessão existe e não expirou.
+     */
+    virtual bool validarSessao(const string& token, EMAIL* email) = 0;
+
+    /**
+     * @brief Encerra a sessão (logout).
+     * @return true se a sessão existia.
+     */
+    virtual bool encerrarSessao(const string& token) = 0;
+
+    /**
+     * @brief Encerra todas as sessões de um gerente.
+     * @details Aberturas em andamento para o mesmo gerente não geram sessões
+     * que escapem à revogação: elas autenticam de novo antes de gravar o token.
+     * @return Quantidade de sessões encerradas.
+     */
+    virtual size_t revogarSessoes(const EMAIL& email) = 0;
+
+    virtual ~ISSessao() {}
+};
+
 /**
  * @class ISPessoa
  * @brief Interface para o serviço de gestão de pessoas (Gerentes e Hóspedes).
@@ -80,9 +155,80 @@ public:
     virtual Hospede lerHospede(const EMAIL& email) = 0;
     virtual list<Hospede> listarHospedes() = 0;
 
+    /**
+     * @brief Busca hóspedes pelo nome, tolerando erros de digitação e sem diferenciar maiúsculas de minúsculas.
+     * @param nome Nome completo, como digitado.
+     * @param distanciaMaxima Máximo de letras inseridas, removidas ou trocadas em relação ao nome cadastrado.
+     * @param limite Máximo de hóspedes devolvidos.
+     * @return Os mais próximos primeiro; empates em ordem alfabética do nome.
+     */
+    virtual vector<Hospede> buscarHospedes(const string& nome, unsigned distanciaMaxima, size_t limite) = 0;
+
+    /**
+     * @brief Atualiza o hóspede só se ninguém o alterou desde a leitura (concorrência otimista).
+     * @param hospede Dados atualizados.
+     * @param versaoEsperada Versão obtida por lerHospede (getVersao()).
+     * @return ResultadoAtualizacao::CONFLITO se a versão armazenada for outra; nada é gravado.
+     */
+    virtual ResultadoAtualizacao atualizarHospede(const Hospede& hospede, unsigned long long versaoEsperada) = 0;
+
     virtual ~ISPessoa() {}
 };
 
+/**
+ * @struct Cotacao
+ * @brief Valor calculado para a estadia em um quarto, resultado de ISReserva::cotarQuartos.
+ */
+struct Cotacao {
+    Numero quarto;
+    Dinheiro valor;              ///< Zero quando há erro.
+    const char* erro = nullptr;  ///< Motivo de não haver valor (ex.: total acima do limite de Dinheiro).
+};
+
+/**
+ * @struct IndicadoresHotel
+ * @brief Ocupação, receita e diária média (ADR) de um hotel em uma janela de datas.
+ *
+ * @details A receita fica em centavos (long long) porque o agregado de muitas
+ * reservas excede o limite do domínio Dinheiro. Cada reserva contribui com a
+ * fração do seu valor correspondente às noites dentro da janela.
+ */
+struct IndicadoresHotel {
+    Codigo hotel;
+    long long noitesDisponiveis = 0; ///< Quartos do hotel multiplicados pelas noites da janela.
+    long long noitesOcupadas = 0;
+    long long receita = 0;           ///< Em centavos.
+
+    /// @brief Fração das noites disponíveis que foram vendidas (0 a 1).
+    double ocupacao() const {
+        return noitesDisponiveis > 0 ? static_cast<double>(noitesOcupadas) / noitesDisponiveis : 0.0;
+    }
+
+    /// @brief Diária média (ADR) em centavos: receita dividida pelas noites ocupadas.
+    long long diariaMedia() const {
+        return noitesOcupadas > 0 ? (receita + noitesOcupadas / 2) / noitesOcupadas : 0;
+    }
+};
+
+/**
+ * @struct RelatorioOcupacao
+ * @brief Indicadores por hotel e consolidados, resultado de ISReserva::gerarRelatorio.
+ */
+struct RelatorioOcupacao {
+    vector<IndicadoresHotel> hoteis;
+    IndicadoresHotel consolidado;    ///< Soma de todos os hotéis (código vazio).
+};
+
+/**
+ * @enum SituacaoSolicitacao
+ * @brief Resultado de ISReserva::solicitarReserva.
+ */
+enum class SituacaoSolicitacao {
+    CRIADA,     ///< Reserva criada na hora.
+    EM_ESPERA,  ///< Datas ocupadas: o pedido aguarda na lista de espera do quarto.
+    RECUSADA    ///< Pedido inválido (código repetido, sem noites, quarto inexistente).
+};
+
 /**
  * @class ISReserva
  * @brief Interface para o serviço de gestão de reservas e infraestrutura hoteleira.
@@ -98,6 +244,14 @@ public:
     virtual Hotel lerHotel(const Codigo& codigo) = 0;
     virtual list<Hotel> listarHoteis() = 0;
 
+    /**
+     * @brief Busca hotéis pelo início do nome, sem diferenciar maiúsculas de minúsculas.
+     * @param prefixo Início do nome (vazio casa com todos).
+     * @param limite Máximo de hotéis devolvidos.
+     * @return Os primeiros hotéis em ordem alfabética do nome.
+     */
+    virtual vector<Hotel> buscarHoteis(const string& prefixo, size_t limite) = 0;
+
     // --- CRUD Quarto ---
     virtual bool criarQuarto(const Quarto& quarto) = 0;
     virtual bool deletarQuarto(const Numero& numero) = 0;
@@ -109,18 +263,185 @@ public:
     /**
      * @brief Cria uma nova reserva.
      * @details Deve verificar conflitos de datas antes de confirmar a criação.
+     * O valor informado é ignorado: o serviço grava o calculado pelo motor
+     * tarifário a partir da diária do quarto (o mesmo de cotarReserva).
      * @param reserva Objeto Reserva a ser criado.
-     * @return true se criada com sucesso, false se houver conflito ou erro.
+     * @return true se criada com sucesso, false se houver conflito ou erro
+     * (inclusive total acima do limite de Dinheiro).
      */
     virtual bool criarReserva(const Reserva& reserva) = 0;
+
+    /**
+     * @brief Cria uma reserva com chave de idempotência.
+     * @details Repetições com a mesma chave, enquanto ela for lembrada, devolvem
+     * o resultado da primeira chamada sem verificar nada de novo; assim quem
+     * reenvia após um timeout sabe se a reserva original foi feita.
+     * @param chaveIdempotencia Chave escolhida pelo chamador; vazia equivale a criarReserva(reserva).
+     */
+    virtual bool criarReserva(const Reserva& reserva, const string& chaveIdempotencia) = 0;
     virtual bool deletarReserva(const Codigo& codigo) = 0;
+
+    /**
+     * @brief Atualiza uma reserva, inclusive mudando-a de quarto ou de datas.
+     * @details Segue as regras de criarReserva: quarto existente, partida
+     * depois da chegada e nenhuma sobreposição com outra reserva do quarto de
+     * destino (a própria reserva não conta). O valor é recalculado.
+     * @return false se a reserva não existir ou alguma regra for violada.
+     */
     virtual bool atualizarReserva(const Reserva& reserva) = 0;
     virtual Reserva lerReserva(const Codigo& codigo) = 0;
     virtual list<Reserva> listarReservas() = 0;
 
+    /**
+     * @brief Cria as reservas de um grupo (vários quartos), todas ou nenhuma.
+     * @details Cada reserva é verificada como em criarReserva, inclusive contra
+     * as demais do próprio grupo; se alguma for recusada, nenhuma é criada.
+     * @param reservas Uma reserva por quarto, cada uma com seu código.
+     * @return Quartos das reservas recusadas (sem repetição, na ordem recebida);
+     * vazio se todas foram criadas.
+     */
+    virtual vector<Numero> criarReservasGrupo(const vector<Reserva>& reservas) = 0;
+
+    // --- Lista de espera ---
+    /**
+     * @brief Cria a reserva ou, se as datas estiverem ocupadas, a coloca na lista de espera do quarto.
+     * @details Quando deletarReserva ou atualizarReserva liberam noites do quarto,
+     * os pedidos em espera que as disputam são criados automaticamente, por
+     * prioridade (maior primeiro) e, dentro dela, por ordem de chegada.
+     * @param prioridade Maior valor, maior prioridade.
+     */
+    virtual SituacaoSolicitacao solicitarReserva(const Reserva& reserva, unsigned prioridade) = 0;
+    virtual bool cancelarEspera(const Codigo& codigo) = 0;
+    /// @brief Pedidos em espera do quarto, na ordem em que seriam atendidos.
+    virtual list<Reserva> listarEspera(const Numero& quarto) = 0;
+
+    // --- Consultas sem cópia ---
+    /**
+     * @brief Como lerHotel/lerQuarto, mas devolvem um instantâneo imutável compartilhado.
+     * @details O instantâneo não muda depois de entregue; alterações posteriores
+     * aparecem na próxima consulta.
+     * @throw std::runtime_error Se não for encontrado.
+     */
+    virtual shared_ptr<const Hotel> obterHotel(const Codigo& codigo) = 0;
+    virtual shared_ptr<const Quarto> obterQuarto(const Numero& numero) = 0;
+
+    // --- Atualização com versão esperada (concorrência otimista) ---
+    /**
+     * @brief Atualizam a entidade só se a versão armazenada for a lida pelo chamador.
+     * @details Em caso de CONFLITO nada é gravado: o chamador relê, reaplica a
+     * alteração e tenta de novo. RECUSADO indica uma regra de negócio violada
+     * (hotel ou quarto referenciado inexistente; para reservas, também as
+     * regras de atualizarReserva).
+     * @param versaoEsperada Versão obtida por lerHotel/lerQuarto/lerReserva (getVersao()).
+     */
+    virtual ResultadoAtualizacao atualizarHotel(const Hotel& hotel, unsigned long long versaoEsperada) = 0;
+    virtual ResultadoAtualizacao atualizarQuarto(const Quarto& quarto, unsigned long long versaoEsperada) = 0;
+    virtual ResultadoAtualizacao atualizarReserva(const Reserva& reserva, unsigned long long versaoEsperada) = 0;
+
+    // --- Tarifação ---
+    /**
+     * @brief Calcula o valor de uma estadia a partir da diária do quarto e das regras tarifárias.
+     * @param quarto Número (PK) do quarto.
+     * @param chegada Data de chegada (primeira noite).
+     * @param partida Data de partida (não cobrada).
+     * @return Dinheiro Valor total da estadia.
+     * @throw std::runtime_error Se o quarto não for encontrado.
+     * @throw std::invalid_argument Se o período não tiver noites ou o total exceder o limite de Dinheiro.
+     */
+    virtual Dinheiro cotarReserva(const Numero& quarto, const Data& chegada, const Data& partida) = 0;
+
+    /**
+     * @brief Cota de uma só vez todos os quartos com a capacidade mínima pedida.
+     * @details Quartos cujo total exceder o limite de Dinheiro vêm com Cotacao::erro preenchido.
+     * @return Cotações na ordem de listagem dos quartos.
+     * @throw std::invalid_argument Se o período não tiver noites.
+     */
+    virtual vector<Cotacao> cotarQuartos(const Data& chegada, const Data& partida,
+                                         const Capacidade& capacidadeMinima) = 0;
+
+    /**
+     * @brief Calcula ocupação, receita e ADR de cada hotel na janela [inicio, fim).
+     * @return Relatório com um item por hotel, na ordem de listagem dos hotéis.
+     * @throw std::invalid_argument Se a janela não tiver noites.
+     */
+    virtual RelatorioOcupacao gerarRelatorio(const Data& inicio, const Data& fim) = 0;
+
     virtual ~ISReserva() {}
 };
 
+/**
+ * @class ISPessoaAssincrono
+ * @brief Variante assíncrona de ISPessoa.
+ *
+ * @details Cada método agenda a operação correspondente de ISPessoa e retorna
+ * imediatamente. O resultado (ou a exceção lançada) é obtido pelo futuro;
+ * operações de um mesmo chamador não têm ordem garantida entre si.
+ */
+class ISPessoaAssincrono {
+public:
+    virtual future<bool> criarGerente(const Gerente& gerente) = 0;
+    virtual future<bool> deletarGerente(const EMAIL& email) = 0;
+    virtual future<bool> atualizarGerente(const Gerente& gerente) = 0;
+    virtual future<Gerente> lerGerente(const EMAIL& email) = 0;
+    virtual future<list<Gerente>> listarGerentes() = 0;
+
+    virtual future<bool> criarHospede(const Hospede& hospede) = 0;
+    virtual future<bool> deletarHospede(const EMAIL& email) = 0;
+    virtual future<bool> atualizarHospede(const Hospede& hospede) = 0;
+    virtual future<Hospede> lerHospede(const EMAIL& email) = 0;
+    virtual future<list<Hospede>> listarHospedes() = 0;
+    virtual future<vector<Hospede>> buscarHospedes(const string& nome, unsigned distanciaMaxima, size_t limite) = 0;
+    virtual future<ResultadoAtualizacao> atualizarHospede(const Hospede& hospede,
+                                                          unsigned long long versaoEsperada) = 0;
+
+    virtual ~ISPessoaAssincrono() {}
+};
+
+/**
+ * @class ISReservaAssincrono
+ * @brief Variante assíncrona de ISReserva (mesma semântica, resultados em futuros).
+ */
+class ISReservaAssincrono {
+public:
+    virtual future<bool> criarHotel(const Hotel& hotel) = 0;
+    virtual future<bool> deletarHotel(const Codigo& codigo) = 0;
+    virtual future<bool> atualizarHotel(const Hotel& hotel) = 0;
+    virtual future<Hotel> lerHotel(const Codigo& codigo) = 0;
+    virtual future<list<Hotel>> listarHoteis() = 0;
+    virtual future<vector<Hotel>> buscarHoteis(const string& prefixo, size_t limite) = 0;
+
+    virtual future<bool> criarQuarto(const Quarto& quarto) = 0;
+    virtual future<bool> deletarQuarto(const Numero& numero) = 0;
+    virtual future<bool> atualizarQuarto(const Quarto& quarto) = 0;
+    virtual future<Quarto> lerQuarto(const Numero& numero) = 0;
+    virtual future<list<Quarto>> listarQuartos() = 0;
+
+    virtual future<bool> criarReserva(const Reserva& reserva) = 0;
+    virtual future<bool> criarReserva(const Reserva& reserva, const string& chaveIdempotencia) = 0;
+    virtual future<bool> deletarReserva(const Codigo& codigo) = 0;
+    virtual future<bool> atualizarReserva(const Reserva& reserva) = 0;
+    virtual future<Reserva> lerReserva(const Codigo& codigo) = 0;
+    virtual future<list<Reserva>> listarReservas() = 0;
+    virtual future<vector<Numero>> criarReservasGrupo(const vector<Reserva>& reservas) = 0;
+    virtual future<SituacaoSolicitacao> solicitarReserva(const Reserva& reserva, unsigned prioridade) = 0;
+    virtual future<bool> cancelarEspera(const Codigo& codigo) = 0;
+    virtual future<list<Reserva>> listarEspera(const Numero& quarto) = 0;
+    virtual future<shared_ptr<const Hotel>> obterHotel(const Codigo& codigo) = 0;
+    virtual future<shared_ptr<const Quarto>> obterQuarto(const Numero& numero) = 0;
+
+    virtual future<ResultadoAtualizacao> atualizarHotel(const Hotel& hotel, unsigned long long versaoEsperada) = 0;
+    virtual future<ResultadoAtualizacao> atualizarQuarto(const Quarto& quarto, unsigned long long versaoEsperada) = 0;
+    virtual future<ResultadoAtualizacao> atualizarReserva(const Reserva& reserva,
+                                                          unsigned long long versaoEsperada) = 0;
+
+    virtual future<Dinheiro> cotarReserva(const Numero& quarto, const Data& chegada, const Data& partida) = 0;
+    virtual future<vector<Cotacao>> cotarQuartos(const Data& chegada, const Data& partida,
+                                                 const Capacidade& capacidadeMinima) = 0;
+    virtual future<RelatorioOcupacao> gerarRelatorio(const Data& inicio, const Data& fim) = 0;
+
+    virtual ~ISReservaAssincrono() {}
+};
+
 // ====================================================================
 // CAMADA DE APRESENTAÇÃO (Presentation Interfaces)
 // ====================================================================
@@ -140,6 +461,14 @@ public:
      */
     virtual bool autenticar(EMAIL& email) = 0;
 
+    /**
+     * @brief Executa o fluxo de login abrindo uma sessão no serviço de sessões.
+     * @param email Referência para armazenar o email do usuário autenticado.
+     * @param token Referência para armazenar o token da sessão aberta.
+     * @return true se o login for bem-sucedido.
+     */
+    virtual bool autenticar(EMAIL& email, string& token) = 0;
+
     /**
      * @brief Executa o fluxo de cadastro de novo gerente.
      * @return true se o cadastro for bem-sucedido.
@@ -156,6 +485,11 @@ public:
      */
     virtual void setISPessoa(ISPessoa* servico) = 0;
 
+    /**
+     * @brief Injeta a dependência do serviço de sessões (necessário para login com token).
+     */
+    virtual void setISSessao(ISSessao* servico) = 0;
+
     virtual ~IAAutenticacao() {}
 };
 
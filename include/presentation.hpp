@@ -4,6 +4,7 @@
 #include "interfaces.hpp"
 #include "domains.hpp"
 #include <iostream>
+#include <string>
 
 using namespace std;
 
@@ -21,6 +22,9 @@ class CntrMAAutenticacao : public IAAutenticacao {
 private:
     ISAutenticacao* servicoAutenticacao;
     ISPessoa* servicoPessoa;
+    ISSessao* servicoSessao = nullptr;
+
+    bool lerCredenciais(EMAIL& email, Senha& senha);
 
 public:
     void setISAutenticacao(ISAutenticacao* servico) override {
@@ -31,7 +35,12 @@ public:
         this->servicoPessoa = servico;
     }
 
+    void setISSessao(ISSessao* servico) override {
+        this->servicoSessao = servico;
+    }
+
     bool autenticar(EMAIL& email) override;
+    bool autenticar(EMAIL& email, string& token) override;
     bool cadastrar() override;
 };
 
@@ -96,6 +105,7 @@ public:
     void menuQuartos();
     void menuReservas();
     void menuHospedes();
+    void menuRelatorio();
 };
 
 
@@ -115,8 +125,10 @@ private:
     IAAutenticacao* cntrAutenticacao;
     IAPessoal* cntrPessoal;
     IAReserva* cntrReserva;
+    ISSessao* servicoSessao = nullptr;
 
     EMAIL emailUsuarioLogado;
+    string tokenSessao;
     bool autenticado;
 
 public:
@@ -126,6 +138,11 @@ public:
     void setCntrPessoal(IAPessoal* cntr) { this->cntrPessoal = cntr; }
     void setCntrReserva(IAReserva* cntr) { this->cntrReserva = cntr; }
 
+    /**
+     * @brief Ativa o login por sessão: o token é revalidado a cada operação do menu.
+     */
+    void setISSessao(ISSessao* servico) { this->servicoSessao = servico; }
+
     /**
      * @brief Inicia o loop principal da aplicação.
      */
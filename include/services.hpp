@@ -2,8 +2,26 @@
 #define SERVICOS_HPP_INCLUDED
 
 #include "interfaces.hpp" // Contém ISAutenticacao, ISPessoa, ISReserva
+#include "analises.hpp"
+#include "credenciais.hpp"
 #include "domains.hpp"
+#include "escalonador.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <limits>
 #include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -13,20 +31,85 @@ class ContainerHospede;
 class ContainerHotel;
 class ContainerQuarto;
 class ContainerReserva;
+class Transacao;
 
 // ====================================================================
 // 1. MÓDULO DE SERVIÇO: AUTENTICAÇÃO (MSA)
 // ====================================================================
 
+/**
+ * @class LimitadorTentativas
+ * @brief Contadores de falhas de login por email e por origem, sem travas.
+ *
+ * @details Cada tabela tem tamanho fixo, e cada chave tem duas células
+ * candidatas. Uma célula é um único atomic<uint64_t> com janela de tempo
+ * (24 bits), impressão digital da chave (24 bits) e contagem (16 bits),
+ * atualizado por compare-and-swap. Uma falha incrementa a célula com a mesma
+ * impressão ou, se não houver, substitui a candidata de menor contagem. Assim,
+ * uma enxurrada de chaves distintas com uma falha cada desloca apenas outras
+ * chaves de contagem baixa, sem bloquear chaves inocentes, e as chaves
+ * insistentes permanecem. Ao virar a janela, a contagem cai pela metade; após
+ * duas janelas sem falhas, zera. A memória não cresce com o número de emails
+ * ou origens distintos.
+ */
+class LimitadorTentativas {
+private:
+    static constexpr size_t POSICOES = 1 << 14; // Por tabela: 128 KiB
+
+    struct Tabela {
+        atomic<uint64_t> posicoes[POSICOES];
+    };
+
+    Tabela porEmail;
+    Tabela porOrigem;
+    uint32_t limiteEmail;
+    uint32_t limiteOrigem;
+    long long duracaoJanela; // Segundos
+
+    uint32_t janelaAtual() const;
+    static uint64_t misturar(uint64_t chave);
+    static uint32_t contagemEfetiva(uint64_t celula, uint32_t janela);
+    static uint32_t consultar(const Tabela& tabela, uint64_t chave, uint32_t janela);
+    static void registrar(Tabela& tabela, uint64_t chave, uint32_t janela);
+
+public:
+    /**
+     * @param limiteEmail Falhas toleradas por email antes do bloqueio.
+     * @param limiteOrigem Falhas toleradas por origem antes do bloqueio.
+     * @param janela Duração de cada janela de contagem.
+     */
+    explicit LimitadorTentativas(uint32_t limiteEmail = 5, uint32_t limiteOrigem = 50,
+                                 chrono::seconds janela = chrono::minutes(5));
+
+    /**
+     * @brief Indica se uma nova tentativa pode ser conferida.
+     * @param origem Origem da tentativa; vazia dispensa o controle por origem.
+     */
+    bool permitido(const EMAIL& email, const string& origem) const;
+
+    /**
+     * @brief Registra uma tentativa com credenciais inválidas.
+     */
+    void registrarFalha(const EMAIL& email, const string& origem);
+};
+
 /**
  * @class CntrMSAutenticacao
  * @brief Controlador de Serviço de Autenticação.
  *
  * @details Implementa a lógica de verificação de credenciais consultando o container de gerentes.
+ * A conferência do hash da senha, cara por projeto, roda no VerificadorSenhas; quando
+ * a fila dele está cheia, autenticar lança std::runtime_error em vez de esperar.
+ * autenticarAssincrono só faz na thread chamadora as consultas baratas e entrega o
+ * resultado, e o registro de falha, na thread de verificação; uma exceção da
+ * conferência chega a aoConcluir, e autenticar a relança.
+ * Antes da conferência, o LimitadorTentativas barra emails e origens com falhas
+ * demais, também com std::runtime_error.
  */
 class CntrMSAutenticacao : public ISAutenticacao {
 private:
     ContainerGerente* container;
+    LimitadorTentativas limitador;
 
 public:
     /**
@@ -37,6 +120,15 @@ public:
      */
     bool autenticar(const EMAIL& email, const Senha& senha) override;
 
+    /**
+     * @brief Versão de autenticar que também limita as falhas por origem.
+     * @throw std::runtime_error Se o email ou a origem estiverem temporariamente bloqueados.
+     */
+    bool autenticar(const EMAIL& email, const Senha& senha, const string& origem) override;
+
+    void autenticarAssincrono(const EMAIL& email, const Senha& senha, const string& origem,
+                              function<void(bool, exception_ptr)> aoConcluir) override;
+
     /**
      * @brief Define o container de gerentes a ser utilizado.
      * @param container Ponteiro para o container.
@@ -44,6 +136,86 @@ public:
     void setContainer(ContainerGerente* container) { this->container = container; }
 };
 
+/**
+ * @class CntrMSSessao
+ * @brief Controlador de Serviço de Sessões.
+ *
+ * @details Emite tokens aleatórios de 128 bits (32 caracteres hexadecimais)
+ * após autenticar as credenciais pelo ISAutenticacao. As sessões ficam em
+ * fragmentos de tabela hash, cada um com seu shared_mutex: a validação só
+ * pega a trava de leitura do fragmento do token e renova o último acesso com
+ * uma escrita atômica, então validações concorrentes não se bloqueiam.
+ *
+ * Uma sessão expira por inatividade ou por tempo total desde a abertura. As
+ * expiradas são removidas ao serem encontradas e, periodicamente, por uma
+ * varredura de um fragmento a cada ABERTURAS_POR_VARREDURA aberturas.
+ * Um índice reverso por email permite revogar as sessões de um gerente.
+ * Cada revogação avança uma época; uma abertura que veja a época mudar
+ * durante a autenticação autentica de novo, para não criar uma sessão de um
+ * gerente excluído nesse intervalo. abrirSessaoAssincrona grava o token na
+ * conclusão da autenticação, sem esperar por ela; abrirSessao espera esse futuro.
+ * Ordem das travas: travaDonos antes da trava de um fragmento.
+ */
+class CntrMSSessao : public ISSessao {
+private:
+    struct Sessao {
+        EMAIL email;
+        long long criacao;                 // Instantes em ns do relógio monotônico
+        atomic<long long> ultimoAcesso;
+        Sessao(const EMAIL& email, long long agora) : email(email), criacao(agora), ultimoAcesso(agora) {}
+    };
+
+    struct Fragmento {
+        shared_mutex trava;
+        unordered_map<string, Sessao> sessoes;
+    };
+
+    static constexpr size_t FRAGMENTOS = 64;
+    static constexpr size_t SESSOES_PREVISTAS = 100000;   // Dimensiona as tabelas na construção
+    static constexpr size_t ABERTURAS_POR_VARREDURA = 1024;
+
+    ISAutenticacao* servicoAutenticacao;
+    atomic<long long> limiteOcioso;
+    atomic<long long> limiteAbsoluto;
+
+    Fragmento fragmentos[FRAGMENTOS];
+    mutex travaDonos;
+    unordered_map<EMAIL, vector<string>> tokensPorGerente; // Índice reverso para revogação
+    atomic<uint64_t> revogacoes{0};                          // Época: avança sob travaDonos
+    atomic<size_t> aberturas{0};
+
+    static long long agora();
+    static string gerarToken();
+    Fragmento& fragmentoDe(const string& token);
+    bool expirada(const Sessao& sessao, long long instante) const;
+    void removerDoIndice(const EMAIL& email, const string& token);
+    void tentarAbrir(const EMAIL& email, const Senha& senha, const string& origem,
+                     shared_ptr<promise<string>> promessa);
+    void varrerFragmento(Fragmento& fragmento);
+
+public:
+    CntrMSSessao();
+
+    string abrirSessao(const EMAIL& email, const Senha& senha, const string& origem) override;
+    future<string> abrirSessaoAssincrona(const EMAIL& email, const Senha& senha, const string& origem) override;
+    bool validarSessao(const string& token, EMAIL* email) override;
+    bool encerrarSessao(const string& token) override;
+    size_t revogarSessoes(const EMAIL& email) override;
+
+    /**
+     * @brief Define os prazos de expiração (padrão: 30 minutos ocioso, 12 horas no total).
+     * @throw std::invalid_argument Se algum prazo não for positivo.
+     */
+    void setLimites(chrono::seconds ocioso, chrono::seconds absoluto);
+
+    /**
+     * @brief Quantidade de sessões armazenadas (inclui expiradas ainda não removidas).
+     */
+    size_t contarSessoes();
+
+    void setISAutenticacao(ISAutenticacao* servico) { this->servicoAutenticacao = servico; }
+};
+
 // ====================================================================
 // 2. MÓDULO DE SERVIÇO: PESSOAL (MSP)
 // ====================================================================
@@ -53,12 +225,14 @@ public:
  * @brief Controlador de Serviço de Pessoas.
  *
  * @details Implementa a lógica de negócio para Gerentes e Hóspedes, garantindo
- * regras como unicidade de email (PK).
+ * regras como unicidade de email (PK). Cada operação toca um único container,
+ * e a trava dele basta para chamadas concorrentes.
  */
 class CntrMSPessoa : public ISPessoa {
 private:
     ContainerGerente* containerGerentes;
     ContainerHospede* containerHospedes;
+    ISSessao* servicoSessao = nullptr; // Opcional: sessões revogadas ao excluir o gerente
 
 public:
     // Implementação dos métodos da interface ISPessoa para Gerentes
@@ -74,28 +248,403 @@ public:
     bool atualizarHospede(const Hospede& hospede) override;
     Hospede lerHospede(const EMAIL& email) override;
     list<Hospede> listarHospedes() override;
+    vector<Hospede> buscarHospedes(const string& nome, unsigned distanciaMaxima, size_t limite) override;
+    ResultadoAtualizacao atualizarHospede(const Hospede& hospede, unsigned long long versaoEsperada) override;
 
     // Métodos de injeção de dependência
     void setContainerGerente(ContainerGerente* container) { this->containerGerentes = container; }
     void setContainerHospede(ContainerHospede* container) { this->containerHospedes = container; }
+    void setISSessao(ISSessao* servico) { this->servicoSessao = servico; }
 };
 
 // ====================================================================
 // 3. MÓDULO DE SERVIÇO: RESERVAS E INFRAESTRUTURA (MSR)
 // ====================================================================
 
+/**
+ * @struct RegrasTarifarias
+ * @brief Configuração das regras aplicadas pelo MotorTarifario.
+ *
+ * @details Todos os percentuais são expressos em pontos-base (100 = 1%).
+ * O fator de cada noite é 100% somado ao ajuste sazonal do mês e, nas noites de sexta
+ * e sábado, ao acréscimo de fim de semana. O desconto por permanência é aplicado
+ * sobre o total, usando a maior faixa cujo mínimo de noites foi atingido.
+ */
+struct RegrasTarifarias {
+    unsigned int acrescimoFimDeSemana = 0;
+    int ajusteSazonal[13] = {}; // Indexado pelo mês (1 = JAN); valores negativos são descontos
+    vector<pair<int, unsigned int>> descontosPermanencia; // (noites mínimas, desconto)
+};
+
+/**
+ * @class MotorTarifario
+ * @brief Calcula o valor de estadias a partir da diária do quarto.
+ *
+ * @details O fator da estadia (soma dos fatores das noites) depende apenas do período,
+ * sendo calculado por segmentos de mês com o Calendario, sem laço por noite. Na cotação
+ * em lote ele é calculado uma única vez e cada quarto custa apenas duas multiplicações
+ * inteiras. Os arredondamentos seguem as regras de Dinheiro (meio centavo para cima).
+ */
+class MotorTarifario {
+private:
+    RegrasTarifarias regras;
+
+    long long fatorEstadia(const Data& chegada, int noites) const;
+    unsigned int descontoPermanencia(int noites) const;
+    static int contarNoites(const Data& chegada, const Data& partida);
+
+public:
+    /**
+     * @brief Maior fator de uma noite (100% + ajuste sazonal + acréscimo de fim de semana), em pontos-base.
+     * @details Com ele, a diária máxima de Dinheiro multiplicada pelo fator da
+     * estadia mais longa que o Calendario permite, mais os arredondamentos,
+     * ainda cabe em long long (cerca de 2500%).
+     */
+    static constexpr long long FATOR_NOITE_MAXIMO =
+        (numeric_limits<long long>::max() - 10000) / Dinheiro::MAXIMO / Calendario::ultimoSerial();
+
+    /**
+     * @brief Define as regras tarifárias.
+     * @throw std::invalid_argument Se algum ajuste sazonal for inferior a -100%, se o fator de
+     * alguma noite exceder FATOR_NOITE_MAXIMO ou se algum desconto for superior a 100%.
+     */
+    void setRegras(const RegrasTarifarias& regras);
+    const RegrasTarifarias& getRegras() const { return regras; }
+
+    /**
+     * @brief Calcula o valor da estadia para uma diária.
+     * @throw std::invalid_argument Se o período não tiver noites ou o total exceder o limite de Dinheiro.
+     */
+    Dinheiro calcular(const Dinheiro& diaria, const Data& chegada, const Data& partida) const;
+
+    /**
+     * @brief Calcula em lote o total, em centavos, para várias diárias no mesmo período.
+     * @param diarias Diárias em centavos.
+     * @param quantidade Número de diárias.
+     * @param totais Saída com um total por diária (pode exceder o limite de Dinheiro).
+     * @throw std::invalid_argument Se o período não tiver noites.
+     */
+    void cotar(const long long* diarias, size_t quantidade,
+               const Data& chegada, const Data& partida, long long* totais) const;
+};
+
+/**
+ * @class RegistroIdempotencia
+ * @brief Resultados de operações por chave de idempotência, com validade e capacidade limitadas.
+ *
+ * @details Quem repete uma chamada com a mesma chave (ex.: um canal de vendas
+ * que reenvia após um timeout) recebe o resultado da primeira execução, sem
+ * que a operação rode de novo. As chaves ficam em fragmentos de tabela hash,
+ * cada um com sua trava, que só é segurada para consultar ou registrar a
+ * chave, nunca durante a operação. Uma repetição que chega enquanto a
+ * primeira execução ainda corre espera o resultado dela (shared_future).
+ *
+ * Cada fragmento guarda as chaves também em ordem de chegada; como a validade
+ * é a mesma para todas, essa é a ordem de expiração. As expiradas saem pelo
+ * início da fila a cada registro, e, com o fragmento cheio, a mais antiga
+ * sai mesmo antes de expirar. Se a operação lançar exceção, a chave é
+ * esquecida e a próxima repetição executa de novo.
+ */
+class RegistroIdempotencia {
+private:
+    struct Entrada {
+        shared_future<bool> resultado;
+        long long expiracao;               // Instante em ns do relógio monotônico
+    };
+
+    struct Fragmento {
+        mutex trava;
+        unordered_map<string, Entrada> entradas;
+        deque<pair<string, long long>> chegada; // (chave, expiração), da mais antiga à mais nova
+    };
+
+    static constexpr size_t FRAGMENTOS = 64;
+
+    Fragmento fragmentos[FRAGMENTOS];
+    size_t capacidadeFragmento;
+    long long validade;
+
+    static long long agora();
+    Fragmento& fragmentoDe(const string& chave);
+    static void descartarAntigas(Fragmento& fragmento, long long instante, size_t limite);
+
+public:
+    /**
+     * @param capacidade Chaves guardadas ao todo (divididas entre os fragmentos).
+     * @param validade Tempo durante o qual uma repetição recebe o resultado original.
+     */
+    explicit RegistroIdempotencia(size_t capacidade = 100000, chrono::seconds validade = chrono::hours(24));
+
+    /**
+     * @brief Executa a operação na primeira chamada com a chave; nas seguintes, devolve o mesmo resultado.
+     * @throw Repassa a exceção da operação (a chave não é registrada).
+     */
+    bool executar(const string& chave, const function<bool()>& operacao);
+
+    /**
+     * @brief Quantidade de chaves guardadas (inclui expiradas ainda não removidas).
+     */
+    size_t tamanho();
+};
+
+/**
+ * @class ListaEspera
+ * @brief Pedidos de reserva à espera de datas ocupadas, indexados por quarto e chegada.
+ *
+ * @details Cada quarto mantém seus pedidos ordenados pela data de chegada e a
+ * maior estadia já pedida. Ao liberar o intervalo [inicio, fim), só disputam
+ * as noites os pedidos com chegada em [inicio - maior estadia, fim), obtidos
+ * por busca binária, sem percorrer a lista inteira; os demais continuam
+ * bloqueados pelas reservas que já os bloqueavam. Um índice por código
+ * permite cancelar um pedido em tempo constante.
+ *
+ * Não é segura para uso concorrente: CntrMSReserva a protege com travaEspera.
+ */
+class ListaEspera {
+private:
+    struct Pedido {
+        Reserva reserva;
+        unsigned prioridade;
+        unsigned long long ordem; // Ordem de chegada: desempata a prioridade
+    };
+
+    using Pedidos = multimap<int, Pedido>; // Serial da chegada -> pedido
+
+    struct EsperaQuarto {
+        Pedidos porChegada;
+        int maiorEstadia = 0; // Em noites; só volta a zero quando o quarto fica sem pedidos
+    };
+
+    unordered_map<Numero, EsperaQuarto> porQuarto;
+    unordered_map<Codigo, Pedidos::iterator> porCodigo;
+    unsigned long long proximaOrdem = 0;
+
+    static vector<Reserva> ordenar(vector<const Pedido*>& pedidos);
+
+public:
+    /**
+     * @return false se já houver um pedido em espera com o mesmo código.
+     */
+    bool incluir(const Reserva& reserva, unsigned prioridade);
+    bool remover(const Codigo& codigo);
+    void removerQuarto(const Numero& quarto);
+
+    /**
+     * @brief Pedidos do quarto cujas estadias cruzam [inicio, fim), na ordem de atendimento.
+     */
+    vector<Reserva> candidatas(const Numero& quarto, const Data& inicio, const Data& fim) const;
+
+    /**
+     * @brief Todos os pedidos do quarto, na ordem de atendimento.
+     */
+    vector<Reserva> listar(const Numero& quarto) const;
+
+    size_t tamanho() const { return porCodigo.size(); }
+};
+
+/**
+ * @struct EstatisticasCache
+ * @brief Contadores acumulados de uma CacheLRU.
+ */
+struct EstatisticasCache {
+    size_t acertos = 0;
+    size_t faltas = 0;
+    size_t entradas = 0;   ///< Guardadas no momento da consulta.
+};
+
+/**
+ * @class CacheLRU
+ * @brief Cache limitada de instantâneos imutáveis, dividida em fragmentos com descarte LRU.
+ *
+ * @details Guarda shared_ptr<const Valor>: quem recebe um instantâneo pode
+ * usá-lo sem travas e sem cópia, mesmo depois de ele ser invalidado. Cada
+ * fragmento tem sua trava, uma lista do uso mais recente ao mais antigo e um
+ * índice por chave; um acerto move a entrada para o início da lista e, com o
+ * fragmento cheio, sai a do fim. A cache não consulta a origem dos dados: quem
+ * a preenche e invalida é o dono (ver CntrMSReserva::obterHotel).
+ */
+template <typename Chave, typename Valor>
+class CacheLRU {
+private:
+    using Uso = list<pair<Chave, shared_ptr<const Valor>>>;
+
+    struct Fragmento {
+        mutex trava;
+        Uso uso;                                       // Mais recente no início
+        unordered_map<Chave, typename Uso::iterator> posicoes;
+    };
+
+    static constexpr size_t FRAGMENTOS = 16;
+
+    Fragmento fragmentos[FRAGMENTOS];
+    size_t capacidadeFragmento;
+    atomic<size_t> acertos{0};
+    atomic<size_t> faltas{0};
+
+    Fragmento& fragmentoDe(const Chave& chave) { return fragmentos[hash<Chave>()(chave) % FRAGMENTOS]; }
+
+public:
+    /**
+     * @param capacidade Entradas guardadas ao todo (divididas entre os fragmentos).
+     */
+    explicit CacheLRU(size_t capacidade = 4096) : capacidadeFragmento(max<size_t>(1, capacidade / FRAGMENTOS)) {}
+
+    /**
+     * @brief Instantâneo guardado para a chave, ou nullptr (conta acerto ou falta).
+     */
+    shared_ptr<const Valor> buscar(const Chave& chave);
+
+    void guardar(const Chave& chave, shared_ptr<const Valor> valor);
+    void invalidar(const Chave& chave);
+    void limpar();
+    EstatisticasCache getEstatisticas();
+};
+
+template <typename Chave, typename Valor>
+shared_ptr<const Valor> CacheLRU<Chave, Valor>::buscar(const Chave& chave) {
+    Fragmento& fragmento = fragmentoDe(chave);
+    lock_guard<mutex> bloqueio(fragmento.trava);
+    auto it = fragmento.posicoes.find(chave);
+    if (it == fragmento.posicoes.end()) {
+        faltas.fetch_add(1, memory_order_relaxed);
+        return nullptr;
+    }
+    fragmento.uso.splice(fragmento.uso.begin(), fragmento.uso, it->second);
+    acertos.fetch_add(1, memory_order_relaxed);
+    return it->second->second;
+}
+
+template <typename Chave, typename Valor>
+void CacheLRU<Chave, Valor>::guardar(const Chave& chave, shared_ptr<const Valor> valor) {
+    Fragmento& fragmento = fragmentoDe(chave);
+    lock_guard<mutex> bloqueio(fragmento.trava);
+    auto it = fragmento.posicoes.find(chave);
+    if (it != fragmento.posicoes.end()) {
+        it->second->second = std::move(valor);
+        fragmento.uso.splice(fragmento.uso.begin(), fragmento.uso, it->second);
+        return;
+    }
+    if (fragmento.posicoes.size() >= capacidadeFragmento) {
+        fragmento.posicoes.erase(fragmento.uso.back().first);
+        fragmento.uso.pop_back();
+    }
+    fragmento.uso.emplace_front(chave, std::move(valor));
+    fragmento.posicoes.emplace(chave, fragmento.uso.begin());
+}
+
+template <typename Chave, typename Valor>
+void CacheLRU<Chave, Valor>::invalidar(const Chave& chave) {
+    Fragmento& fragmento = fragmentoDe(chave);
+    lock_guard<mutex> bloqueio(fragmento.trava);
+    auto it = fragmento.posicoes.find(chave);
+    if (it == fragmento.posicoes.end()) return;
+    fragmento.uso.erase(it->second);
+    fragmento.posicoes.erase(it);
+}
+
+template <typename Chave, typename Valor>
+void CacheLRU<Chave, Valor>::limpar() {
+    for (auto& fragmento : fragmentos) {
+        lock_guard<mutex> bloqueio(fragmento.trava);
+        fragmento.uso.clear();
+        fragmento.posicoes.clear();
+    }
+}
+
+template <typename Chave, typename Valor>
+EstatisticasCache CacheLRU<Chave, Valor>::getEstatisticas() {
+    EstatisticasCache estatisticas;
+    estatisticas.acertos = acertos.load(memory_order_relaxed);
+    estatisticas.faltas = faltas.load(memory_order_relaxed);
+    for (auto& fragmento : fragmentos) {
+        lock_guard<mutex> bloqueio(fragmento.trava);
+        estatisticas.entradas += fragmento.posicoes.size();
+    }
+    return estatisticas;
+}
+
+/**
+ * @enum PoliticaExclusao
+ * @brief Tratamento dos dependentes ao excluir um hotel ou um quarto.
+ */
+enum class PoliticaExclusao {
+    CASCATA,    ///< Exclui também os quartos do hotel e as reservas de cada quarto.
+    RESTRINGIR  ///< Recusa a exclusão enquanto houver dependentes.
+};
+
 /**
  * @class CntrMSReserva
  * @brief Controlador de Serviço de Reservas e Infraestrutura.
  *
  * @details Responsável pela lógica de hotéis, quartos e reservas.
  * Inclui a validação crítica de conflito de datas em reservas.
+ * As referências quarto -> hotel e reserva -> quarto são verificadas na criação
+ * e na atualização; a exclusão segue a PoliticaExclusao configurada, usando os
+ * índices reversos dos containers (custo proporcional aos dependentes).
+ * Mantém uma BaseAnalitica para os relatórios, recarregada sob demanda após
+ * qualquer alteração feita por este serviço; com um Escalonador configurado,
+ * a varredura roda nele em Prioridade::BAIXA, sem criar threads por relatório.
+ *
+ * As alterações verificam um container e alteram outro (ex.: conflito de datas
+ * antes de incluir a reserva), então pegam a trava exclusiva do serviço; as
+ * consultas simples contam apenas com as travas dos containers. A exceção é
+ * criarReserva, a operação mais frequente: ela pega a trava do serviço
+ * compartilhada e só a faixa de travasQuartos do quarto reservado, de modo
+ * que reservas em quartos diferentes correm em paralelo e as do mesmo quarto
+ * fazem a verificação de conflito e a inclusão sem intercalar.
+ * atualizarReserva faz o mesmo com as faixas do quarto atual e do novo, e
+ * deletarReserva com a faixa do quarto da reserva; ambas recomeçam se a
+ * reserva mudar de quarto antes de obtê-las. Reservas de
+ * grupo e transações só de reservas (confirmar) pegam as faixas de todos os
+ * seus quartos em ordem crescente de índice, o que as impede de se esperarem
+ * em ciclo. Ordem das travas: travaAnalises, trava do serviço, faixas dos
+ * quartos, travaEspera, travas dos containers.
+ *
+ * Pedidos recusados por conflito em solicitarReserva entram na ListaEspera
+ * ainda sob a faixa do quarto; como as operações que liberam noites pegam a
+ * trava exclusiva do serviço ou a faixa do quarto liberado, nenhuma liberação
+ * escapa entre a verificação e a entrada na lista.
+ *
+ * Hotéis e quartos lidos ficam em caches LRU de instantâneos imutáveis. Uma
+ * falta lê o container e guarda o instantâneo sob a trava compartilhada do
+ * serviço; as alterações invalidam as chaves afetadas sob a exclusiva, então
+ * um instantâneo antigo nunca é guardado depois da sua invalidação. Hotéis e
+ * quartos devem ser alterados só por este serviço (transações, por confirmar).
  */
 class CntrMSReserva : public ISReserva {
 private:
     ContainerReserva* containerReservas;
     ContainerHotel* containerHoteis;
     ContainerQuarto* containerQuartos;
+    MotorTarifario motorTarifario;
+    BaseAnalitica baseAnalitica;
+    atomic<bool> baseDesatualizada{true}; // Alguma alteração desde o último carregamento
+    PoliticaExclusao politicaExclusao = PoliticaExclusao::CASCATA;
+    mutable shared_mutex trava;    // Exclusiva nas alterações, compartilhada na tarifação e em criarReserva
+    mutex travaAnalises;           // Protege baseAnalitica
+    Escalonador* escalonador = nullptr; // Opcional: executa a varredura dos relatórios
+
+    static constexpr size_t FAIXAS_QUARTOS = 64;
+    mutex travasQuartos[FAIXAS_QUARTOS]; // Faixa = número do quarto módulo FAIXAS_QUARTOS
+    RegistroIdempotencia idempotencia;   // Chaves de criarReserva
+    ListaEspera listaEspera;
+    mutex travaEspera;                   // Protege listaEspera
+    CacheLRU<Codigo, Hotel> cacheHoteis;
+    CacheLRU<Numero, Quarto> cacheQuartos;
+    static thread_local const CntrMSReserva* servicoEmCondicao; // Já detém a trava: avalia uma condição de confirmar
+
+    shared_lock<shared_mutex> travarLeitura() const;
+    bool avaliarCondicao(const function<bool()>& condicao);
+    vector<Reserva> lerAlteradas(const Transacao& transacao) const;
+
+    SituacaoSolicitacao incluirReserva(const Reserva& reserva);
+    bool precificar(Reserva& reserva, const Dinheiro& diaria) const;
+    ResultadoAtualizacao alterarReserva(const Reserva& reserva, const unsigned long long* versaoEsperada);
+    void promoverEspera(const Numero& quarto, const Data& inicio, const Data& fim);
+
+    mutex& travaDoQuarto(const Numero& numero) {
+        return travasQuartos[static_cast<size_t>(numero.getValor()) % FAIXAS_QUARTOS];
+    }
 
 public:
     // Implementação dos métodos da interface ISReserva para Hotéis
@@ -104,6 +653,7 @@ public:
     bool atualizarHotel(const Hotel& hotel) override;
     Hotel lerHotel(const Codigo& codigo) override;
     list<Hotel> listarHoteis() override;
+    vector<Hotel> buscarHoteis(const string& prefixo, size_t limite) override;
 
     // Implementação dos métodos da interface ISReserva para Quartos
     bool criarQuarto(const Quarto& quarto) override;
@@ -114,15 +664,161 @@ public:
 
     // Implementação dos métodos da interface ISReserva para Reservas
     bool criarReserva(const Reserva& reserva) override;
+    bool criarReserva(const Reserva& reserva, const string& chaveIdempotencia) override;
     bool deletarReserva(const Codigo& codigo) override;
     bool atualizarReserva(const Reserva& reserva) override;
     Reserva lerReserva(const Codigo& codigo) override;
     list<Reserva> listarReservas() override;
+    vector<Numero> criarReservasGrupo(const vector<Reserva>& reservas) override;
+
+    // Lista de espera
+    SituacaoSolicitacao solicitarReserva(const Reserva& reserva, unsigned prioridade) override;
+    bool cancelarEspera(const Codigo& codigo) override;
+    list<Reserva> listarEspera(const Numero& quarto) override;
+
+    // Consultas sem cópia, pelas caches
+    shared_ptr<const Hotel> obterHotel(const Codigo& codigo) override;
+    shared_ptr<const Quarto> obterQuarto(const Numero& numero) override;
+    EstatisticasCache getEstatisticasCacheHoteis() { return cacheHoteis.getEstatisticas(); }
+    EstatisticasCache getEstatisticasCacheQuartos() { return cacheQuartos.getEstatisticas(); }
+
+    // Atualização com versão esperada
+    ResultadoAtualizacao atualizarHotel(const Hotel& hotel, unsigned long long versaoEsperada) override;
+    ResultadoAtualizacao atualizarQuarto(const Quarto& quarto, unsigned long long versaoEsperada) override;
+    ResultadoAtualizacao atualizarReserva(const Reserva& reserva, unsigned long long versaoEsperada) override;
+
+    // Tarifação
+    Dinheiro cotarReserva(const Numero& quarto, const Data& chegada, const Data& partida) override;
+    vector<Cotacao> cotarQuartos(const Data& chegada, const Data& partida,
+                                 const Capacidade& capacidadeMinima) override;
+    void setRegrasTarifarias(const RegrasTarifarias& regras) {
+        unique_lock<shared_mutex> bloqueio(trava);
+        motorTarifario.setRegras(regras);
+    }
+
+    // Análises
+    RelatorioOcupacao gerarRelatorio(const Data& inicio, const Data& fim) override;
+    void setEscalonador(Escalonador* escalonador) { this->escalonador = escalonador; }
+
+    /**
+     * @brief Confirma uma transação sobre hotéis, quartos ou reservas.
+     * @details Uma transação que só altera reservas (e, se quiser, pessoas)
+     * segura, como criarReserva, a trava compartilhada do serviço e as faixas
+     * dos quartos envolvidos: os das reservas incluídas ou atualizadas e os
+     * atuais das atualizadas ou removidas. Transações em quartos de faixas
+     * diferentes confirmam em paralelo. Se uma reserva mudar de quarto antes
+     * das faixas serem obtidas, elas são soltas e a confirmação recomeça. Com
+     * hotéis ou quartos na transação, segura a trava exclusiva do serviço e
+     * esvazia as caches. Em ambos os casos marca a base analítica como
+     * desatualizada e oferece à lista de espera as noites liberadas.
+     *
+     * A condição, se informada, é avaliada antes de aplicar, já sob essas
+     * travas: ela pode usar as consultas do serviço (lerQuarto, cotarReserva...),
+     * mas não as operações que alteram dados. As travas dos containers só são
+     * pegas ao aplicar as operações, e as senhas de gerentes da transação são
+     * derivadas antes de qualquer trava (Transacao::aguardarDerivacoes).
+     * @return false se a condição recusar ou alguma operação falhar (nada é alterado).
+     */
+    bool confirmar(Transacao& transacao, const function<bool()>& condicao = nullptr);
+
+    // Integridade referencial
+    void setPoliticaExclusao(PoliticaExclusao politica) {
+        unique_lock<shared_mutex> bloqueio(trava);
+        this->politicaExclusao = politica;
+    }
 
     // Métodos de injeção de dependência
-    void setContainerReserva(ContainerReserva* cR) { this->containerReservas = cR; }
-    void setContainerHotel(ContainerHotel* cH) { this->containerHoteis = cH; }
-    void setContainerQuarto(ContainerQuarto* cQ) { this->containerQuartos = cQ; }
+    void setContainerReserva(ContainerReserva* cR) { this->containerReservas = cR; baseDesatualizada = true; }
+    void setContainerHotel(ContainerHotel* cH) { this->containerHoteis = cH; baseDesatualizada = true; }
+    void setContainerQuarto(ContainerQuarto* cQ) { this->containerQuartos = cQ; baseDesatualizada = true; }
+};
+
+// ====================================================================
+// 4. SERVIÇOS ASSÍNCRONOS
+// ====================================================================
+
+/**
+ * @class CntrMSPessoaAssincrono
+ * @brief Implementa ISPessoaAssincrono executando um ISPessoa no Escalonador.
+ *
+ * @details Cada chamada copia os argumentos para a tarefa e retorna o futuro
+ * na hora; o serviço síncrono segue disponível para quem prefere bloquear.
+ * Operações pontuais entram em Prioridade::NORMAL e listagens, cotações em
+ * lote e relatórios em Prioridade::BAIXA, para que varreduras longas não
+ * atrasem leituras e alterações. O serviço e o escalonador devem sobreviver
+ * às tarefas agendadas.
+ */
+class CntrMSPessoaAssincrono : public ISPessoaAssincrono {
+private:
+    ISPessoa* servico;
+    Escalonador* escalonador;
+
+public:
+    CntrMSPessoaAssincrono(ISPessoa* servico, Escalonador* escalonador)
+        : servico(servico), escalonador(escalonador) {}
+
+    future<bool> criarGerente(const Gerente& gerente) override;
+    future<bool> deletarGerente(const EMAIL& email) override;
+    future<bool> atualizarGerente(const Gerente& gerente) override;
+    future<Gerente> lerGerente(const EMAIL& email) override;
+    future<list<Gerente>> listarGerentes() override;
+
+    future<bool> criarHospede(const Hospede& hospede) override;
+    future<bool> deletarHospede(const EMAIL& email) override;
+    future<bool> atualizarHospede(const Hospede& hospede) override;
+    future<Hospede> lerHospede(const EMAIL& email) override;
+    future<list<Hospede>> listarHospedes() override;
+    future<vector<Hospede>> buscarHospedes(const string& nome, unsigned distanciaMaxima, size_t limite) override;
+    future<ResultadoAtualizacao> atualizarHospede(const Hospede& hospede, unsigned long long versaoEsperada) override;
+};
+
+/**
+ * @class CntrMSReservaAssincrono
+ * @brief Implementa ISReservaAssincrono executando um ISReserva no Escalonador.
+ */
+class CntrMSReservaAssincrono : public ISReservaAssincrono {
+private:
+    ISReserva* servico;
+    Escalonador* escalonador;
+
+public:
+    CntrMSReservaAssincrono(ISReserva* servico, Escalonador* escalonador)
+        : servico(servico), escalonador(escalonador) {}
+
+    future<bool> criarHotel(const Hotel& hotel) override;
+    future<bool> deletarHotel(const Codigo& codigo) override;
+    future<bool> atualizarHotel(const Hotel& hotel) override;
+    future<Hotel> lerHotel(const Codigo& codigo) override;
+    future<list<Hotel>> listarHoteis() override;
+    future<vector<Hotel>> buscarHoteis(const string& prefixo, size_t limite) override;
+
+    future<bool> criarQuarto(const Quarto& quarto) override;
+    future<bool> deletarQuarto(const Numero& numero) override;
+    future<bool> atualizarQuarto(const Quarto& quarto) override;
+    future<Quarto> lerQuarto(const Numero& numero) override;
+    future<list<Quarto>> listarQuartos() override;
+
+    future<bool> criarReserva(const Reserva& reserva) override;
+    future<bool> criarReserva(const Reserva& reserva, const string& chaveIdempotencia) override;
+    future<bool> deletarReserva(const Codigo& codigo) override;
+    future<bool> atualizarReserva(const Reserva& reserva) override;
+    future<Reserva> lerReserva(const Codigo& codigo) override;
+    future<list<Reserva>> listarReservas() override;
+    future<vector<Numero>> criarReservasGrupo(const vector<Reserva>& reservas) override;
+    future<SituacaoSolicitacao> solicitarReserva(const Reserva& reserva, unsigned prioridade) override;
+    future<bool> cancelarEspera(const Codigo& codigo) override;
+    future<list<Reserva>> listarEspera(const Numero& quarto) override;
+    future<shared_ptr<const Hotel>> obterHotel(const Codigo& codigo) override;
+    future<shared_ptr<const Quarto>> obterQuarto(const Numero& numero) override;
+
+    future<ResultadoAtualizacao> atualizarHotel(const Hotel& hotel, unsigned long long versaoEsperada) override;
+    future<ResultadoAtualizacao> atualizarQuarto(const Quarto& quarto, unsigned long long versaoEsperada) override;
+    future<ResultadoAtualizacao> atualizarReserva(const Reserva& reserva, unsigned long long versaoEsperada) override;
+
+    future<Dinheiro> cotarReserva(const Numero& quarto, const Data& chegada, const Data& partida) override;
+    future<vector<Cotacao>> cotarQuartos(const Data& chegada, const Data& partida,
+                                         const Capacidade& capacidadeMinima) override;
+    future<RelatorioOcupacao> gerarRelatorio(const Data& inicio, const Data& fim) override;
 };
 
 #endif // SERVICOS_HPP_INCLUDED
@@ -0,0 +1,126 @@
+#ifndef TRANSACOES_HPP_INCLUDED
+#define TRANSACOES_HPP_INCLUDED
+
+#include "containers.hpp"
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <shared_mutex>
+#include <vector>
+
+using namespace std;
+
+// ====================================================================
+// MÓDULO DE TRANSAÇÕES (Alterações atômicas entre containers)
+// ====================================================================
+
+/**
+ * @class Transacao
+ * @brief Agrupa inclusões, atualizações e remoções em vários containers, aplicadas
+ * todas ou nenhuma.
+ *
+ * @details As operações são só registradas até confirmar(). Na confirmação, as
+ * travas exclusivas dos containers envolvidos são obtidas uma única vez, sempre
+ * na mesma ordem global (Gerente, Hóspede, Hotel, Quarto, Reserva; endereço
+ * para containers do mesmo tipo), o que impede duas transações de se esperarem
+ * em ciclo. Transações sobre containers distintos confirmam em paralelo. As
+ * travas só cobrem a aplicação das operações já preparadas (senhas derivadas,
+ * entidades copiadas), como em uma alteração avulsa do container.
+ *
+ * Cada operação aplicada deixa em um registro de desfazer o estado anterior
+ * da entidade. Se uma operação falhar (chave repetida na inclusão, inexistente
+ * na remoção ou atualização, versão diferente da esperada) ou lançar exceção,
+ * o registro é executado de trás para frente antes de liberar as travas, e
+ * nenhuma outra thread chega a ver o estado parcial. Entidades restauradas
+ * recuperam a versão anterior e voltam ao fim da lista do container.
+ *
+ * A transação não verifica regras de negócio (conflito de datas, chaves
+ * estrangeiras); para hotéis, quartos e reservas, confirme-a por
+ * CntrMSReserva::confirmar. Não deve ser confirmada de dentro de uma função
+ * passada a percorrer* de um container envolvido.
+ */
+class Transacao {
+private:
+    using Desfazer = vector<function<void()>>;
+
+    struct Operacao {
+        int ordem;                 // Posição do tipo de container na ordem global das travas
+        const void* container;
+        shared_mutex* trava;
+        function<bool(Desfazer&)> aplicar; // false = falhou sem alterar nada
+    };
+
+    vector<Operacao> operacoes;
+    vector<shared_future<Credencial>> derivacoes; // Senhas sendo derivadas no VerificadorSenhas
+    vector<Numero> quartosReservados;             // Quartos das reservas incluídas ou atualizadas
+    vector<Codigo> reservasAlteradas;             // Reservas atualizadas ou removidas
+
+    template <typename Container, typename Entidade, typename Chave>
+    void registrarInclusao(int ordem, Container& container, const Entidade& entidade, const Chave& chave);
+    template <typename Entidade, typename Container, typename Chave>
+    void registrarRemocao(int ordem, Container& container, const Chave& chave);
+    template <typename Container, typename Entidade>
+    void registrarAtualizacao(int ordem, Container& container, const Entidade& entidade,
+                              bool verificarVersao, unsigned long long versaoEsperada);
+
+public:
+    // --- Gerente (a derivação da senha começa no registro, no VerificadorSenhas) ---
+    void incluir(ContainerGerente& container, const Gerente& gerente);
+    void remover(ContainerGerente& container, const EMAIL& email);
+    void atualizar(ContainerGerente& container, const Gerente& gerente);
+
+    // --- Hóspede ---
+    void incluir(ContainerHospede& container, const Hospede& hospede);
+    void remover(ContainerHospede& container, const EMAIL& email);
+    void atualizar(ContainerHospede& container, const Hospede& hospede);
+    void atualizar(ContainerHospede& container, const Hospede& hospede, unsigned long long versaoEsperada);
+
+    // --- Hotel ---
+    void incluir(ContainerHotel& container, const Hotel& hotel);
+    void remover(ContainerHotel& container, const Codigo& codigo);
+    void atualizar(ContainerHotel& container, const Hotel& hotel);
+    void atualizar(ContainerHotel& container, const Hotel& hotel, unsigned long long versaoEsperada);
+
+    // --- Quarto ---
+    void incluir(ContainerQuarto& container, const Quarto& quarto);
+    void remover(ContainerQuarto& container, const Numero& numero);
+    void atualizar(ContainerQuarto& container, const Quarto& quarto);
+    void atualizar(ContainerQuarto& container, const Quarto& quarto, unsigned long long versaoEsperada);
+
+    // --- Reserva ---
+    void incluir(ContainerReserva& container, const Reserva& reserva);
+    void remover(ContainerReserva& container, const Codigo& codigo);
+    void atualizar(ContainerReserva& container, const Reserva& reserva);
+    void atualizar(ContainerReserva& container, const Reserva& reserva, unsigned long long versaoEsperada);
+
+    /**
+     * @brief Aplica todas as operações registradas, na ordem do registro, ou nenhuma.
+     * @details O registro é esvaziado em qualquer caso; a transação pode ser reutilizada.
+     * Espera as derivações de senha pendentes antes de pegar as travas.
+     * @return true se todas foram aplicadas; false se alguma falhou e tudo foi desfeito.
+     * @throw Repassa a exceção de uma operação, depois de desfazer as anteriores.
+     */
+    bool confirmar();
+
+    /**
+     * @brief Espera as derivações de senha pendentes, sem pegar travas.
+     * @details Quem pega travas próprias antes de confirmar() deve chamá-lo
+     * antes delas, para não segurá-las durante o hash.
+     * @throw Repassa a falha de uma derivação, depois de descartar as operações.
+     */
+    void aguardarDerivacoes();
+
+    /**
+     * @brief Descarta as operações registradas, sem aplicá-las.
+     */
+    void cancelar();
+
+    size_t tamanho() const { return operacoes.size(); }
+
+    // --- Escopo das operações registradas (usado por CntrMSReserva::confirmar) ---
+    bool alteraHoteisOuQuartos() const;
+    const vector<Numero>& getQuartosReservados() const { return quartosReservados; }
+    const vector<Codigo>& getReservasAlteradas() const { return reservasAlteradas; }
+};
+
+#endif // TRANSACOES_HPP_INCLUDED
@@ -23,17 +23,26 @@ int main() {
         ContainerQuarto    cQuarto;
         ContainerReserva   cReserva;
 
-        // 2. Serviços
+        // Espelhos colunares para cotações e relatórios (mantidos em sincronia pelos containers)
+        cQuarto.habilitarColunas();
+        cReserva.habilitarColunas();
+
+        // 2. Serviços (o escalonador vem antes para ser destruído depois deles)
+        Escalonador        escalonador;
         CntrMSAutenticacao msAutenticacao;
         CntrMSPessoa       msPessoa;
         CntrMSReserva      msReserva;
+        CntrMSSessao       msSessao;
 
         msAutenticacao.setContainer(&cGerente);
+        msSessao.setISAutenticacao(&msAutenticacao);
+        msPessoa.setISSessao(&msSessao);
         msPessoa.setContainerGerente(&cGerente);
         msPessoa.setContainerHospede(&cHospede);
         msReserva.setContainerReserva(&cReserva);
         msReserva.setContainerHotel(&cHotel);
         msReserva.setContainerQuarto(&cQuarto);
+        msReserva.setEscalonador(&escalonador);
 
         // 3. Apresentação
         CntrMAAutenticacao maAutenticacao;
@@ -43,6 +52,7 @@ int main() {
         // --- CORREÇÃO AQUI: Injetando dependências extras ---
         maAutenticacao.setISAutenticacao(&msAutenticacao);
         maAutenticacao.setISPessoa(&msPessoa); // Necessário para Cadastrar Gerente
+        maAutenticacao.setISSessao(&msSessao);
 
         maPessoal.setISPessoa(&msPessoa);
 
@@ -54,23 +64,28 @@ int main() {
         mai.setCntrAutenticacao(&maAutenticacao);
         mai.setCntrPessoal(&maPessoal);
         mai.setCntrReserva(&maReserva);
+        mai.setISSessao(&msSessao);
 
         // 5. Carga Inicial (Admin)
-        // Criando admin inicial para não ficar bloqueado se não quiser criar conta
-        try {
-            Gerente admin;
-            Nome nome; nome.setValor("Administrador");
-            EMAIL email; email.setValor("admin@hotel.com");
-            Senha senha; senha.setValor("A1b!2"); // Senha válida
-            Ramal ramal; ramal.setValor(1);
-
-            admin.setNome(nome);
-            admin.setEmail(email);
-            admin.setSenha(senha);
-            admin.setRamal(ramal);
-
-            cGerente.incluir(admin);
-        } catch (...) {}
+        // Criando admin inicial para não ficar bloqueado se não quiser criar conta.
+        // Os literais são verificados na compilação: um valor inválido impede o build.
+        constexpr Literal<Nome>  NOME_ADMIN("Administrador");
+        constexpr Literal<EMAIL> EMAIL_ADMIN("admin@hotel.com");
+        constexpr Literal<Senha> SENHA_ADMIN("A1b!2");
+        constexpr Literal<Ramal> RAMAL_ADMIN(1);
+
+        Gerente admin;
+        Nome nome; nome.setValor(NOME_ADMIN);
+        EMAIL email; email.setValor(EMAIL_ADMIN);
+        Senha senha; senha.setValor(SENHA_ADMIN);
+        Ramal ramal; ramal.setValor(RAMAL_ADMIN);
+
+        admin.setNome(std::move(nome));
+        admin.setEmail(std::move(email));
+        admin.setSenha(std::move(senha));
+        admin.setRamal(ramal);
+
+        cGerente.incluir(admin);
 
         // 6. Executar
         mai.executar();
@@ -0,0 +1,146 @@
+#include "analises.hpp"
+#include "containers.hpp"
+#include "escalonador.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+using namespace std;
+
+// ====================================================================
+// IMPLEMENTAÇÃO: BASE ANALÍTICA
+// ====================================================================
+
+void BaseAnalitica::carregar(const ContainerHotel& containerHoteis, const ContainerQuarto& containerQuartos,
+                             const ContainerReserva& containerReservas) {
+    hoteis.clear();
+    quartosPorHotel.clear();
+    chegadas.clear();
+    partidas.clear();
+    valores.clear();
+    hotelDaReserva.clear();
+
+    // 1. Hotéis recebem índices densos, usados como posição nos acumuladores
+    unordered_map<Codigo, uint32_t> indiceHotel;
+    containerHoteis.percorrer([&](const Hotel& hotel) {
+        indiceHotel.emplace(hotel.getCodigo(), static_cast<uint32_t>(hoteis.size()));
+        hoteis.push_back(hotel.getCodigo());
+    });
+    quartosPorHotel.assign(hoteis.size(), 0);
+
+    // 2. Cada quarto resolve o seu hotel uma única vez
+    unordered_map<int, uint32_t> hotelDoQuarto;
+    containerQuartos.percorrer([&](const Quarto& quarto) {
+        auto it = indiceHotel.find(quarto.getHotel());
+        if (it == indiceHotel.end()) return;
+        quartosPorHotel[it->second]++;
+        hotelDoQuarto.emplace(quarto.getNumero().getValor(), it->second);
+    });
+
+    // 3. Reservas viram linhas das colunas, já com o hotel resolvido
+    auto adicionar = [&](int quarto, int chegada, int partida, long long valor) {
+        auto it = hotelDoQuarto.find(quarto);
+        if (it == hotelDoQuarto.end()) return;
+        chegadas.push_back(chegada);
+        partidas.push_back(partida);
+        valores.push_back(valor);
+        hotelDaReserva.push_back(it->second);
+    };
+
+    bool carregouColunas = false;
+    containerReservas.lerColunas([&](const ColunasReserva* colunas) {
+        if (!colunas) return;
+        // O espelho colunar já tem os campos prontos: a carga não toca nos objetos
+        chegadas.reserve(colunas->tamanho());
+        partidas.reserve(colunas->tamanho());
+        valores.reserve(colunas->tamanho());
+        hotelDaReserva.reserve(colunas->tamanho());
+        for (size_t i = 0; i < colunas->tamanho(); i++) {
+            adicionar(colunas->getQuartos()[i], colunas->getChegadas()[i],
+                      colunas->getPartidas()[i], colunas->getValores()[i]);
+        }
+        carregouColunas = true;
+    });
+    if (carregouColunas) return;
+
+    containerReservas.percorrer([&](const Reserva& reserva) {
+        adicionar(reserva.getQuarto().getValor(), reserva.getChegada().getSerial(),
+                  reserva.getPartida().getSerial(), reserva.getValor().getCentavos());
+    });
+}
+
+void BaseAnalitica::acumular(size_t primeira, size_t ultima, int inicio, int fim,
+                             long long* noites, long long* receita) const {
+    for (size_t i = primeira; i < ultima; i++) {
+        // Noites da reserva dentro da janela: interseção de [chegada, partida) com [inicio, fim)
+        int dentro = min(partidas[i], fim) - max(chegadas[i], inicio);
+        if (dentro <= 0) continue;
+
+        int total = partidas[i] - chegadas[i];
+        uint32_t hotel = hotelDaReserva[i];
+        noites[hotel] += dentro;
+        receita[hotel] += (dentro == total) ? valores[i] : (valores[i] * dentro + total / 2) / total;
+    }
+}
+
+RelatorioOcupacao BaseAnalitica::calcular(const Data& inicio, const Data& fim, Escalonador* escalonador) const {
+    const int janelaInicio = inicio.getSerial();
+    const int janelaFim = fim.getSerial();
+    if (janelaFim <= janelaInicio) throw invalid_argument("Periodo deve conter ao menos uma noite.");
+
+    const size_t linhas = chegadas.size();
+    const size_t quantidadeHoteis = hoteis.size();
+
+    size_t tarefas = (linhas + LINHAS_POR_TAREFA - 1) / LINHAS_POR_TAREFA;
+    const size_t paralelas = escalonador ? escalonador->getQuantidadeThreads()
+                                         : max(1u, thread::hardware_concurrency());
+    tarefas = max<size_t>(1, min(tarefas, paralelas));
+    const size_t faixa = (linhas + tarefas - 1) / tarefas;
+
+    // Acumuladores privados por tarefa: [noites dos hotéis | receita dos hotéis]
+    vector<long long> parciais(tarefas * 2 * quantidadeHoteis, 0);
+    auto executar = [&](size_t tarefa) {
+        long long* noites = parciais.data() + tarefa * 2 * quantidadeHoteis;
+        acumular(min(linhas, tarefa * faixa), min(linhas, (tarefa + 1) * faixa),
+                 janelaInicio, janelaFim, noites, noites + quantidadeHoteis);
+    };
+
+    if (escalonador) {
+        escalonador->paraCada(tarefas, executar, Prioridade::BAIXA);
+    } else {
+        vector<thread> trabalhadores;
+        trabalhadores.reserve(tarefas - 1);
+        for (size_t tarefa = 1; tarefa < tarefas; tarefa++) {
+            try {
+                trabalhadores.emplace_back(executar, tarefa);
+            } catch (const system_error&) {
+                executar(tarefa); // Sem recursos para outra thread: varre a faixa aqui mesmo
+            }
+        }
+        executar(0);
+        for (auto& trabalhador : trabalhadores) trabalhador.join();
+    }
+
+    // Soma dos parciais e montagem do relatório
+    RelatorioOcupacao relatorio;
+    relatorio.hoteis.resize(quantidadeHoteis);
+    const long long noitesJanela = janelaFim - janelaInicio;
+
+    for (size_t h = 0; h < quantidadeHoteis; h++) {
+        IndicadoresHotel& indicadores = relatorio.hoteis[h];
+        indicadores.hotel = hoteis[h];
+        indicadores.noitesDisponiveis = quartosPorHotel[h] * noitesJanela;
+        for (size_t tarefa = 0; tarefa < tarefas; tarefa++) {
+            const long long* noites = parciais.data() + tarefa * 2 * quantidadeHoteis;
+            indicadores.noitesOcupadas += noites[h];
+            indicadores.receita += noites[quantidadeHoteis + h];
+        }
+
+        relatorio.consolidado.noitesDisponiveis += indicadores.noitesDisponiveis;
+        relatorio.consolidado.noitesOcupadas += indicadores.noitesOcupadas;
+        relatorio.consolidado.receita += indicadores.receita;
+    }
+    return relatorio;
+}
@@ -1,47 +1,291 @@
 #include "containers.hpp"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+// Índices reversos: chave estrangeira -> elementos da lista que a referenciam
+template <typename Mapa, typename Chave, typename Iterador>
+void vincular(Mapa& mapa, const Chave& chave, Iterador elemento) {
+    mapa[chave].push_back(elemento);
+}
+
+template <typename Mapa, typename Chave, typename Iterador>
+void desvincular(Mapa& mapa, const Chave& chave, Iterador elemento) {
+    auto it = mapa.find(chave);
+    if (it == mapa.end()) return;
+    auto& elementos = it->second;
+    for (size_t i = 0; i < elementos.size(); i++) {
+        if (elementos[i] != elemento) continue;
+        elementos[i] = elementos.back();
+        elementos.pop_back();
+        break;
+    }
+    if (elementos.empty()) mapa.erase(it);
+}
+
+// O domínio do e-mail só entra na TabelaDominios quando a pessoa é armazenada
+void internarEmail(Pessoa& pessoa) {
+    pessoa.internarEmail();
+}
+
+} // namespace
 
 // ====================================================================
 // IMPLEMENTAÇÃO: CONTAINER GERENTE
 // ====================================================================
 
+ContainerGerente::ContainerGerente(uint32_t blocosSenha, uint32_t rodadasSenha)
+    : blocosSenha(blocosSenha), rodadasSenha(rodadasSenha) {
+    if (blocosSenha == 0 || rodadasSenha == 0) throw std::invalid_argument("Custos de derivacao devem ser positivos.");
+}
+
 bool ContainerGerente::incluir(const Gerente& gerente) {
-    for (const auto& item : container) {
-        if (item.getEmail().getValor() == gerente.getEmail().getValor()) {
-            return false; // Já existe
-        }
+    // A derivação é cara: roda no VerificadorSenhas, antes da trava, para não bloquear as consultas
+    Credencial credencial = derivar(gerente.getSenha().getValor()).get();
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return incluirSemTrava(gerente, std::move(credencial));
+}
+
+bool ContainerGerente::incluirSemTrava(const Gerente& gerente, Credencial credencial) {
+    if (indice.count(gerente.getEmail())) {
+        return false; // Já existe
     }
     container.push_back(gerente);
+    Gerente& incluido = container.back();
+    incluido.setSenha(Senha()); // Só a credencial guarda a senha
+    internarEmail(incluido);
+    credenciais.emplace(incluido.getEmail(), std::move(credencial));
+    indice.emplace(incluido.getEmail(), std::prev(container.end()));
     return true;
 }
 
 bool ContainerGerente::remover(const EMAIL& email) {
-    for (auto it = container.begin(); it != container.end(); ++it) {
-        if (it->getEmail().getValor() == email.getValor()) {
-            container.erase(it);
-            return true;
-        }
-    }
-    return false;
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return removerSemTrava(email, nullptr, nullptr);
+}
+
+bool ContainerGerente::removerSemTrava(const EMAIL& email, Gerente* removido, Credencial* credencial) {
+    auto it = indice.find(email);
+    if (it == indice.end()) return false;
+    if (removido) *removido = *it->second;
+    if (credencial) *credencial = credenciais[email];
+    container.erase(it->second);
+    indice.erase(it);
+    credenciais.erase(email);
+    return true;
 }
 
 bool ContainerGerente::pesquisar(Gerente* gerente) const {
-    for (const auto& item : container) {
-        if (item.getEmail().getValor() == gerente->getEmail().getValor()) {
-            *gerente = item;
-            return true;
+    std::shared_lock<std::shared_mutex> bloqueio(trava);
+    auto it = indice.find(gerente->getEmail());
+    if (it == indice.end()) return false;
+    *gerente = *it->second;
+    return true;
+}
+
+bool ContainerGerente::atualizar(const Gerente& gerente) {
+    const bool novaSenha = !gerente.getSenha().getValor().empty();
+    Credencial credencial;
+    if (novaSenha) credencial = derivar(gerente.getSenha().getValor()).get();
+
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return atualizarSemTrava(gerente, novaSenha ? &credencial : nullptr, nullptr, nullptr);
+}
+
+bool ContainerGerente::atualizarSemTrava(const Gerente& gerente, const Credencial* credencial,
+                                         Gerente* anterior, Credencial* credencialAnterior) {
+    auto it = indice.find(gerente.getEmail());
+    if (it == indice.end()) return false;
+    if (anterior) *anterior = *it->second;
+    if (credencialAnterior) *credencialAnterior = credenciais[gerente.getEmail()];
+    if (credencial) credenciais[gerente.getEmail()] = *credencial;
+    *it->second = gerente;
+    it->second->setSenha(Senha());
+    internarEmail(*it->second);
+    return true;
+}
+
+bool ContainerGerente::obterCredencial(const EMAIL& email, Credencial* credencial) const {
+    std::shared_lock<std::shared_mutex> bloqueio(trava);
+    auto it = credenciais.find(email);
+    if (it == credenciais.end()) return false;
+    *credencial = it->second;
+    return true;
+}
+
+// ====================================================================
+// IMPLEMENTAÇÃO: ÍNDICE DE TRIGRAMAS
+// ====================================================================
+
+namespace {
+
+// 0 = borda, 1-26 = letras, 27 = espaço, 28 = qualquer outro caractere
+unsigned simboloTrigrama(char c) {
+    const unsigned char u = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+    if (u >= 'a' && u <= 'z') return u - 'a' + 1;
+    return u == ' ' ? 27 : 28;
+}
+
+} // namespace
+
+size_t IndiceTrigramas::extrairTrigramas(std::string_view nome, uint16_t* trigramas) {
+    // Duas bordas antes e depois do nome: tamanho + 2 trigramas, antes de remover repetidos
+    size_t quantidade = 0;
+    unsigned janela = 0;
+    for (size_t i = 0; i < nome.size() + 2 && quantidade < MAXIMO_TRIGRAMAS; i++) {
+        const unsigned simbolo = i < nome.size() ? simboloTrigrama(nome[i]) : 0;
+        janela = ((janela << BITS_SIMBOLO) | simbolo) & (TRIGRAMAS - 1);
+        trigramas[quantidade++] = static_cast<uint16_t>(janela);
+    }
+    std::sort(trigramas, trigramas + quantidade);
+    return static_cast<size_t>(std::unique(trigramas, trigramas + quantidade) - trigramas);
+}
+
+unsigned IndiceTrigramas::distancia(std::string_view a, std::string_view b, unsigned limite) {
+    // Levenshtein em duas linhas, só na faixa |i - j| <= limite; para assim que a linha inteira passa do limite
+    const unsigned fora = limite + 1;
+    if ((a.size() > b.size() ? a.size() - b.size() : b.size() - a.size()) > limite) return fora;
+    unsigned linhas[2][TAMANHO_NOME + 1];
+    unsigned* anterior = linhas[0];
+    unsigned* atual = linhas[1];
+    for (size_t j = 0; j <= b.size(); j++) anterior[j] = static_cast<unsigned>(std::min<size_t>(j, fora));
+    for (size_t i = 1; i <= a.size(); i++) {
+        const size_t inicio = i > limite ? i - limite : 1;
+        const size_t fim = std::min(b.size(), i + limite);
+        atual[inicio - 1] = inicio == 1 ? static_cast<unsigned>(std::min<size_t>(i, fora)) : fora;
+        unsigned menor = atual[inicio - 1];
+        for (size_t j = inicio; j <= fim; j++) {
+            const unsigned troca = anterior[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+            atual[j] = std::min({anterior[j] + 1, atual[j - 1] + 1, troca, fora});
+            menor = std::min(menor, atual[j]);
         }
+        if (fim < b.size()) atual[fim + 1] = fora;
+        if (menor > limite) return fora;
+        std::swap(anterior, atual);
     }
-    return false;
+    return anterior[b.size()];
 }
 
-bool ContainerGerente::atualizar(const Gerente& gerente) {
-    for (auto& item : container) {
-        if (item.getEmail().getValor() == gerente.getEmail().getValor()) {
-            item = gerente;
-            return true;
+std::string IndiceTrigramas::normalizar(const std::string& nome) {
+    std::string normalizado(nome.size(), '\0');
+    for (size_t i = 0; i < nome.size(); i++) {
+        normalizado[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(nome[i])));
+    }
+    return normalizado;
+}
+
+void IndiceTrigramas::indexar(uint32_t posicao) {
+    uint16_t trigramas[MAXIMO_TRIGRAMAS];
+    const size_t quantidade = extrairTrigramas(entradas[posicao].getNome(), trigramas);
+    for (size_t i = 0; i < quantidade; i++) listas[trigramas[i]].push_back(posicao);
+}
+
+void IndiceTrigramas::incluir(const Hospede& hospede) {
+    std::string nome = normalizar(hospede.getNome().getValor());
+    if (nome.size() > TAMANHO_NOME) nome.resize(TAMANHO_NOME);
+
+    auto it = porNome.find(nome);
+    if (it == porNome.end()) {
+        Entrada entrada;
+        entrada.tamanho = static_cast<unsigned char>(nome.size());
+        std::copy(nome.begin(), nome.end(), entrada.nome);
+        const uint32_t posicao = static_cast<uint32_t>(entradas.size());
+        entradas.push_back(std::move(entrada));
+        indexar(posicao);
+        it = porNome.emplace(std::move(nome), posicao).first;
+    } else if (entradas[it->second].hospedes.empty()) {
+        livres--; // Nome de volta antes da compactação: a posição (e suas listas) volta a valer
+    }
+
+    std::vector<const Hospede*>& hospedes = entradas[it->second].hospedes;
+    posicoes[&hospede] = {it->second, static_cast<uint32_t>(hospedes.size())};
+    hospedes.push_back(&hospede);
+}
+
+void IndiceTrigramas::remover(const Hospede& hospede) {
+    auto it = posicoes.find(&hospede);
+    if (it == posicoes.end()) return;
+    std::vector<const Hospede*>& hospedes = entradas[it->second.first].hospedes;
+
+    // Troca com o último homônimo para remover em O(1)
+    const uint32_t indice = it->second.second;
+    hospedes[indice] = hospedes.back();
+    posicoes[hospedes[indice]].second = indice;
+    hospedes.pop_back();
+    posicoes.erase(it);
+
+    if (hospedes.empty() && ++livres >= MINIMO_COMPACTACAO && livres * 2 > entradas.size()) compactar();
+}
+
+void IndiceTrigramas::compactar() {
+    std::vector<Entrada> vivas;
+    vivas.reserve(entradas.size() - livres);
+    for (auto& entrada : entradas) {
+        if (!entrada.hospedes.empty()) vivas.push_back(std::move(entrada));
+    }
+    entradas.swap(vivas);
+    porNome.clear();
+    for (auto& lista : listas) lista.clear();
+    for (uint32_t posicao = 0; posicao < entradas.size(); posicao++) {
+        porNome.emplace(std::string(entradas[posicao].getNome()), posicao);
+        for (const Hospede* hospede : entradas[posicao].hospedes) posicoes[hospede].first = posicao;
+        indexar(posicao);
+    }
+    livres = 0;
+}
+
+std::vector<const Hospede*> IndiceTrigramas::buscar(const std::string& nome, unsigned distanciaMaxima,
+                                                    size_t limite) const {
+    // A distância nunca passa do maior dos dois tamanhos: limites acima disso não
+    // mudam o resultado, e limite + 1 não pode dar a volta (ex.: UINT_MAX)
+    distanciaMaxima = static_cast<unsigned>(std::min<size_t>(distanciaMaxima, std::max(TAMANHO_NOME, nome.size())));
+    std::vector<const Hospede*> encontrados;
+    if (limite == 0 || nome.size() > TAMANHO_NOME + distanciaMaxima) return encontrados;
+    const std::string consulta = normalizar(nome);
+
+    // 1. Candidatas: posições com ao menos T - 3d trigramas em comum com a consulta
+    uint16_t trigramas[MAXIMO_TRIGRAMAS];
+    const size_t quantidade = extrairTrigramas(consulta, trigramas);
+    const long minimo = static_cast<long>(quantidade) - 3 * static_cast<long>(distanciaMaxima);
+
+    std::vector<uint32_t> candidatas;
+    if (minimo <= 0) {
+        for (uint32_t posicao = 0; posicao < entradas.size(); posicao++) candidatas.push_back(posicao);
+    } else {
+        std::vector<unsigned char> comuns(entradas.size(), 0);
+        for (size_t i = 0; i < quantidade; i++) {
+            for (uint32_t posicao : listas[trigramas[i]]) {
+                if (++comuns[posicao] == minimo) candidatas.push_back(posicao);
+            }
         }
     }
-    return false;
+
+    // 2. Verificação pela distância de edição; nomes mais próximos primeiro, depois em ordem alfabética
+    std::vector<std::pair<unsigned, const Entrada*>> aceitas;
+    for (uint32_t posicao : candidatas) {
+        const Entrada& entrada = entradas[posicao];
+        if (entrada.hospedes.empty()) continue;
+        const unsigned d = distancia(consulta, entrada.getNome(), distanciaMaxima);
+        if (d <= distanciaMaxima) aceitas.emplace_back(d, &entrada);
+    }
+    std::sort(aceitas.begin(), aceitas.end(), [](const auto& a, const auto& b) {
+        if (a.first != b.first) return a.first < b.first;
+        return a.second->getNome() < b.second->getNome();
+    });
+
+    // 3. Homônimos em ordem de email (EMAIL::operator<, sem montar o texto), até o limite
+    auto porEmail = [](const Hospede* a, const Hospede* b) { return a->getEmail() < b->getEmail(); };
+    for (const auto& aceita : aceitas) {
+        std::vector<const Hospede*> hospedes = aceita.second->hospedes;
+        const size_t quantidadeNome = std::min(limite - encontrados.size(), hospedes.size());
+        std::partial_sort(hospedes.begin(), hospedes.begin() + quantidadeNome, hospedes.end(), porEmail);
+        encontrados.insert(encontrados.end(), hospedes.begin(), hospedes.begin() + quantidadeNome);
+        if (encontrados.size() == limite) break;
+    }
+    return encontrados;
 }
 
 // ====================================================================
@@ -49,43 +293,171 @@ bool ContainerGerente::atualizar(const Gerente& gerente) {
 // ====================================================================
 
 bool ContainerHospede::incluir(const Hospede& hospede) {
-    for (const auto& item : container) {
-        if (item.getEmail().getValor() == hospede.getEmail().getValor()) {
-            return false;
-        }
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return incluirSemTrava(hospede);
+}
+
+bool ContainerHospede::incluirSemTrava(const Hospede& hospede) {
+    if (indice.count(hospede.getEmail())) {
+        return false; // Já existe
     }
     container.push_back(hospede);
+    container.back().setVersao(1);
+    internarEmail(container.back());
+    indice.emplace(container.back().getEmail(), std::prev(container.end()));
+    nomes.incluir(container.back());
     return true;
 }
 
 bool ContainerHospede::remover(const EMAIL& email) {
-    for (auto it = container.begin(); it != container.end(); ++it) {
-        if (it->getEmail().getValor() == email.getValor()) {
-            container.erase(it);
-            return true;
-        }
-    }
-    return false;
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return removerSemTrava(email, nullptr);
+}
+
+bool ContainerHospede::removerSemTrava(const EMAIL& email, Hospede* removido) {
+    auto it = indice.find(email);
+    if (it == indice.end()) return false;
+    if (removido) *removido = *it->second;
+    nomes.remover(*it->second);
+    container.erase(it->second);
+    indice.erase(it);
+    return true;
 }
 
 bool ContainerHospede::pesquisar(Hospede* hospede) const {
-    for (const auto& item : container) {
-        if (item.getEmail().getValor() == hospede->getEmail().getValor()) {
-            *hospede = item;
-            return true;
-        }
-    }
-    return false;
+    std::shared_lock<std::shared_mutex> bloqueio(trava);
+    auto it = indice.find(hospede->getEmail());
+    if (it == indice.end()) return false;
+    *hospede = *it->second;
+    return true;
+}
+
+std::vector<Hospede> ContainerHospede::buscarPorNome(const std::string& nome, unsigned distanciaMaxima,
+                                                     size_t limite) const {
+    std::shared_lock<std::shared_mutex> bloqueio(trava);
+    std::vector<Hospede> hospedes;
+    for (const Hospede* hospede : nomes.buscar(nome, distanciaMaxima, limite)) hospedes.push_back(*hospede);
+    return hospedes;
 }
 
 bool ContainerHospede::atualizar(const Hospede& hospede) {
-    for (auto& item : container) {
-        if (item.getEmail().getValor() == hospede.getEmail().getValor()) {
-            item = hospede;
-            return true;
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return atualizarSemTrava(hospede, nullptr, nullptr) == ResultadoAtualizacao::ATUALIZADO;
+}
+
+ResultadoAtualizacao ContainerHospede::atualizar(const Hospede& hospede, unsigned long long versaoEsperada) {
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return atualizarSemTrava(hospede, nullptr, &versaoEsperada);
+}
+
+ResultadoAtualizacao ContainerHospede::atualizarSemTrava(const Hospede& hospede, Hospede* anterior,
+                                                         const unsigned long long* versaoEsperada) {
+    auto it = indice.find(hospede.getEmail());
+    if (it == indice.end()) return ResultadoAtualizacao::NAO_ENCONTRADO;
+    if (versaoEsperada && it->second->getVersao() != *versaoEsperada) return ResultadoAtualizacao::CONFLITO;
+    if (anterior) *anterior = *it->second;
+    const unsigned long long versao = it->second->getVersao() + 1;
+    const bool outroNome = it->second->getNome().getValor() != hospede.getNome().getValor();
+    if (outroNome) nomes.remover(*it->second);
+    *it->second = hospede;
+    it->second->setVersao(versao);
+    internarEmail(*it->second);
+    if (outroNome) nomes.incluir(*it->second);
+    return ResultadoAtualizacao::ATUALIZADO;
+}
+
+void ContainerHospede::restaurarSemTrava(const Hospede& hospede) {
+    auto it = indice.find(hospede.getEmail());
+    if (it == indice.end()) {
+        incluirSemTrava(hospede);
+        container.back().setVersao(hospede.getVersao());
+    } else {
+        atualizarSemTrava(hospede, nullptr, nullptr);
+        it->second->setVersao(hospede.getVersao());
+    }
+}
+
+// ====================================================================
+// IMPLEMENTAÇÃO: ÍNDICE DE NOMES
+// ====================================================================
+
+IndiceNomes::Entrada IndiceNomes::criarEntrada(const Hotel& hotel) {
+    const std::string& nome = hotel.getNome().getValor();
+    Entrada entrada;
+    entrada.tamanho = static_cast<unsigned char>(std::min(nome.size(), sizeof(entrada.chave)));
+    for (size_t i = 0; i < entrada.tamanho; i++) {
+        entrada.chave[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(nome[i])));
+    }
+    entrada.hotel = &hotel;
+    return entrada;
+}
+
+bool IndiceNomes::precede(const Entrada& a, const Entrada& b) {
+    int comparacao = a.getChave().compare(b.getChave());
+    if (comparacao != 0) return comparacao < 0;
+    return a.hotel->getCodigo().getValor() < b.hotel->getCodigo().getValor();
+}
+
+void IndiceNomes::fundir() {
+    std::sort(recentes.begin(), recentes.end(), precede);
+    const size_t meio = ordenadas.size();
+    ordenadas.insert(ordenadas.end(), recentes.begin(), recentes.end());
+    std::inplace_merge(ordenadas.begin(), ordenadas.begin() + meio, ordenadas.end(), precede);
+    recentes.clear();
+}
+
+void IndiceNomes::incluir(const Hotel& hotel) {
+    recentes.push_back(criarEntrada(hotel));
+    if (recentes.size() >= LIMITE_RECENTES) fundir();
+}
+
+void IndiceNomes::remover(const Hotel& hotel) {
+    for (size_t i = 0; i < recentes.size(); i++) {
+        if (recentes[i].hotel == &hotel) {
+            recentes[i] = recentes.back();
+            recentes.pop_back();
+            return;
         }
     }
-    return false;
+    const Entrada alvo = criarEntrada(hotel);
+    auto it = std::lower_bound(ordenadas.begin(), ordenadas.end(), alvo, precede);
+    if (it != ordenadas.end() && it->hotel == &hotel) ordenadas.erase(it);
+}
+
+std::vector<const Hotel*> IndiceNomes::buscar(const std::string& prefixo, size_t limite) const {
+    std::vector<const Hotel*> encontrados;
+    if (limite == 0 || prefixo.size() > sizeof(Entrada::chave)) return encontrados;
+
+    std::string chave(prefixo.size(), '\0');
+    for (size_t i = 0; i < prefixo.size(); i++) {
+        chave[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(prefixo[i])));
+    }
+    auto comeca = [&chave](const Entrada& entrada) {
+        return entrada.getChave().substr(0, chave.size()) == chave;
+    };
+
+    // 1. Até limite entradas contíguas do vetor ordenado, a partir da busca binária
+    std::vector<Entrada> candidatas;
+    auto it = std::lower_bound(ordenadas.begin(), ordenadas.end(), chave,
+                               [](const Entrada& entrada, const std::string& valor) {
+                                   return entrada.getChave() < std::string_view(valor);
+                               });
+    for (; it != ordenadas.end() && candidatas.size() < limite && comeca(*it); ++it) candidatas.push_back(*it);
+
+    // 2. Recentes que começam pelo prefixo, intercaladas na ordem
+    const size_t daOrdenada = candidatas.size();
+    for (const auto& entrada : recentes) {
+        if (comeca(entrada)) candidatas.push_back(entrada);
+    }
+    if (candidatas.size() > daOrdenada) {
+        std::sort(candidatas.begin() + daOrdenada, candidatas.end(), precede);
+        std::inplace_merge(candidatas.begin(), candidatas.begin() + daOrdenada, candidatas.end(), precede);
+    }
+
+    const size_t quantidade = std::min(limite, candidatas.size());
+    encontrados.reserve(quantidade);
+    for (size_t i = 0; i < quantidade; i++) encontrados.push_back(candidatas[i].hotel);
+    return encontrados;
 }
 
 // ====================================================================
@@ -93,43 +465,85 @@ bool ContainerHospede::atualizar(const Hospede& hospede) {
 // ====================================================================
 
 bool ContainerHotel::incluir(const Hotel& hotel) {
-    for (const auto& item : container) {
-        if (item.getCodigo().getValor() == hotel.getCodigo().getValor()) {
-            return false;
-        }
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return incluirSemTrava(hotel);
+}
+
+bool ContainerHotel::incluirSemTrava(const Hotel& hotel) {
+    if (indice.count(hotel.getCodigo())) {
+        return false; // Já existe
     }
     container.push_back(hotel);
+    container.back().setVersao(1);
+    indice.emplace(hotel.getCodigo(), std::prev(container.end()));
+    nomes.incluir(container.back());
     return true;
 }
 
 bool ContainerHotel::remover(const Codigo& codigo) {
-    for (auto it = container.begin(); it != container.end(); ++it) {
-        if (it->getCodigo().getValor() == codigo.getValor()) {
-            container.erase(it);
-            return true;
-        }
-    }
-    return false;
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return removerSemTrava(codigo, nullptr);
+}
+
+bool ContainerHotel::removerSemTrava(const Codigo& codigo, Hotel* removido) {
+    auto it = indice.find(codigo);
+    if (it == indice.end()) return false;
+    if (removido) *removido = *it->second;
+    nomes.remover(*it->second);
+    container.erase(it->second);
+    indice.erase(it);
+    return true;
 }
 
 bool ContainerHotel::pesquisar(Hotel* hotel) const {
-    for (const auto& item : container) {
-        if (item.getCodigo().getValor() == hotel->getCodigo().getValor()) {
-            *hotel = item;
-            return true;
-        }
-    }
-    return false;
+    std::shared_lock<std::shared_mutex> bloqueio(trava);
+    auto it = indice.find(hotel->getCodigo());
+    if (it == indice.end()) return false;
+    *hotel = *it->second;
+    return true;
+}
+
+std::vector<Hotel> ContainerHotel::buscarPorPrefixo(const std::string& prefixo, size_t limite) const {
+    std::shared_lock<std::shared_mutex> bloqueio(trava);
+    std::vector<Hotel> hoteis;
+    for (const Hotel* hotel : nomes.buscar(prefixo, limite)) hoteis.push_back(*hotel);
+    return hoteis;
 }
 
 bool ContainerHotel::atualizar(const Hotel& hotel) {
-    for (auto& item : container) {
-        if (item.getCodigo().getValor() == hotel.getCodigo().getValor()) {
-            item = hotel;
-            return true;
-        }
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return atualizarSemTrava(hotel, nullptr, nullptr) == ResultadoAtualizacao::ATUALIZADO;
+}
+
+ResultadoAtualizacao ContainerHotel::atualizar(const Hotel& hotel, unsigned long long versaoEsperada) {
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return atualizarSemTrava(hotel, nullptr, &versaoEsperada);
+}
+
+ResultadoAtualizacao ContainerHotel::atualizarSemTrava(const Hotel& hotel, Hotel* anterior,
+                                                       const unsigned long long* versaoEsperada) {
+    auto it = indice.find(hotel.getCodigo());
+    if (it == indice.end()) return ResultadoAtualizacao::NAO_ENCONTRADO;
+    if (versaoEsperada && it->second->getVersao() != *versaoEsperada) return ResultadoAtualizacao::CONFLITO;
+    if (anterior) *anterior = *it->second;
+    const unsigned long long versao = it->second->getVersao() + 1;
+    const bool outroNome = it->second->getNome().getValor() != hotel.getNome().getValor();
+    if (outroNome) nomes.remover(*it->second);
+    *it->second = hotel;
+    it->second->setVersao(versao);
+    if (outroNome) nomes.incluir(*it->second);
+    return ResultadoAtualizacao::ATUALIZADO;
+}
+
+void ContainerHotel::restaurarSemTrava(const Hotel& hotel) {
+    auto it = indice.find(hotel.getCodigo());
+    if (it == indice.end()) {
+        incluirSemTrava(hotel);
+        container.back().setVersao(hotel.getVersao());
+    } else {
+        atualizarSemTrava(hotel, nullptr, nullptr);
+        it->second->setVersao(hotel.getVersao());
     }
-    return false;
 }
 
 // ====================================================================
@@ -137,43 +551,99 @@ bool ContainerHotel::atualizar(const Hotel& hotel) {
 // ====================================================================
 
 bool ContainerQuarto::incluir(const Quarto& quarto) {
-    for (const auto& item : container) {
-        if (item.getNumero().getValor() == quarto.getNumero().getValor()) {
-            return false;
-        }
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return incluirSemTrava(quarto);
+}
+
+bool ContainerQuarto::incluirSemTrava(const Quarto& quarto) {
+    if (indice.count(quarto.getNumero())) {
+        return false; // Já existe
     }
     container.push_back(quarto);
+    container.back().setVersao(1);
+    indice.emplace(quarto.getNumero(), std::prev(container.end()));
+    vincular(porHotel, quarto.getHotel(), std::prev(container.end()));
+    if (colunas) colunas->incluir(quarto);
     return true;
 }
 
 bool ContainerQuarto::remover(const Numero& numero) {
-    for (auto it = container.begin(); it != container.end(); ++it) {
-        if (it->getNumero().getValor() == numero.getValor()) {
-            container.erase(it);
-            return true;
-        }
-    }
-    return false;
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return removerSemTrava(numero, nullptr);
+}
+
+bool ContainerQuarto::removerSemTrava(const Numero& numero, Quarto* removido) {
+    auto it = indice.find(numero);
+    if (it == indice.end()) return false;
+    if (removido) *removido = *it->second;
+    desvincular(porHotel, it->second->getHotel(), it->second);
+    container.erase(it->second);
+    indice.erase(it);
+    if (colunas) colunas->remover(numero);
+    return true;
 }
 
 bool ContainerQuarto::pesquisar(Quarto* quarto) const {
-    for (const auto& item : container) {
-        if (item.getNumero().getValor() == quarto->getNumero().getValor()) {
-            *quarto = item;
-            return true;
-        }
-    }
-    return false;
+    std::shared_lock<std::shared_mutex> bloqueio(trava);
+    auto it = indice.find(quarto->getNumero());
+    if (it == indice.end()) return false;
+    *quarto = *it->second;
+    return true;
 }
 
 bool ContainerQuarto::atualizar(const Quarto& quarto) {
-    for (auto& item : container) {
-        if (item.getNumero().getValor() == quarto.getNumero().getValor()) {
-            item = quarto;
-            return true;
-        }
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return atualizarSemTrava(quarto, nullptr, nullptr) == ResultadoAtualizacao::ATUALIZADO;
+}
+
+ResultadoAtualizacao ContainerQuarto::atualizar(const Quarto& quarto, unsigned long long versaoEsperada) {
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return atualizarSemTrava(quarto, nullptr, &versaoEsperada);
+}
+
+ResultadoAtualizacao ContainerQuarto::atualizarSemTrava(const Quarto& quarto, Quarto* anterior,
+                                                        const unsigned long long* versaoEsperada) {
+    auto it = indice.find(quarto.getNumero());
+    if (it == indice.end()) return ResultadoAtualizacao::NAO_ENCONTRADO;
+    if (versaoEsperada && it->second->getVersao() != *versaoEsperada) return ResultadoAtualizacao::CONFLITO;
+    if (anterior) *anterior = *it->second;
+    const unsigned long long versao = it->second->getVersao() + 1;
+    if (it->second->getHotel() != quarto.getHotel()) {
+        desvincular(porHotel, it->second->getHotel(), it->second);
+        vincular(porHotel, quarto.getHotel(), it->second);
     }
-    return false;
+    *it->second = quarto;
+    it->second->setVersao(versao);
+    if (colunas) colunas->atualizar(quarto);
+    return ResultadoAtualizacao::ATUALIZADO;
+}
+
+void ContainerQuarto::restaurarSemTrava(const Quarto& quarto) {
+    auto it = indice.find(quarto.getNumero());
+    if (it == indice.end()) {
+        incluirSemTrava(quarto);
+        container.back().setVersao(quarto.getVersao());
+    } else {
+        atualizarSemTrava(quarto, nullptr, nullptr);
+        it->second->setVersao(quarto.getVersao());
+    }
+}
+
+std::vector<Numero> ContainerQuarto::listarPorHotel(const Codigo& hotel) const {
+    std::shared_lock<std::shared_mutex> bloqueio(trava);
+    std::vector<Numero> numeros;
+    auto it = porHotel.find(hotel);
+    if (it == porHotel.end()) return numeros;
+    numeros.reserve(it->second.size());
+    for (const auto& quarto : it->second) numeros.push_back(quarto->getNumero());
+    return numeros;
+}
+
+void ContainerQuarto::habilitarColunas() {
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    if (colunas) return;
+    colunas.reset(new ColunasQuarto());
+    for (const auto& quarto : container) colunas->incluir(quarto);
 }
 
 // ====================================================================
@@ -181,41 +651,211 @@ bool ContainerQuarto::atualizar(const Quarto& quarto) {
 // ====================================================================
 
 bool ContainerReserva::incluir(const Reserva& reserva) {
-    for (const auto& item : container) {
-        if (item.getCodigo().getValor() == reserva.getCodigo().getValor()) {
-            return false;
-        }
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return incluirSemTrava(reserva);
+}
+
+bool ContainerReserva::incluirSemTrava(const Reserva& reserva) {
+    if (indice.count(reserva.getCodigo())) {
+        return false; // Já existe
     }
     container.push_back(reserva);
+    container.back().setVersao(1);
+    indice.emplace(reserva.getCodigo(), std::prev(container.end()));
+    vincular(porQuarto, reserva.getQuarto(), std::prev(container.end()));
+    if (colunas) colunas->incluir(reserva);
     return true;
 }
 
 bool ContainerReserva::remover(const Codigo& codigo) {
-    for (auto it = container.begin(); it != container.end(); ++it) {
-        if (it->getCodigo().getValor() == codigo.getValor()) {
-            container.erase(it);
-            return true;
-        }
-    }
-    return false;
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return removerSemTrava(codigo, nullptr);
+}
+
+bool ContainerReserva::removerSemTrava(const Codigo& codigo, Reserva* removido) {
+    auto it = indice.find(codigo);
+    if (it == indice.end()) return false;
+    if (removido) *removido = *it->second;
+    desvincular(porQuarto, it->second->getQuarto(), it->second);
+    container.erase(it->second);
+    indice.erase(it);
+    if (colunas) colunas->remover(codigo);
+    return true;
 }
 
 bool ContainerReserva::pesquisar(Reserva* reserva) const {
-    for (const auto& item : container) {
-        if (item.getCodigo().getValor() == reserva->getCodigo().getValor()) {
-            *reserva = item;
-            return true;
-        }
-    }
-    return false;
+    std::shared_lock<std::shared_mutex> bloqueio(trava);
+    auto it = indice.find(reserva->getCodigo());
+    if (it == indice.end()) return false;
+    *reserva = *it->second;
+    return true;
 }
 
 bool ContainerReserva::atualizar(const Reserva& reserva) {
-    for (auto& item : container) {
-        if (item.getCodigo().getValor() == reserva.getCodigo().getValor()) {
-            item = reserva;
-            return true;
-        }
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return atualizarSemTrava(reserva, nullptr, nullptr) == ResultadoAtualizacao::ATUALIZADO;
+}
+
+ResultadoAtualizacao ContainerReserva::atualizar(const Reserva& reserva, unsigned long long versaoEsperada) {
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    return atualizarSemTrava(reserva, nullptr, &versaoEsperada);
+}
+
+ResultadoAtualizacao ContainerReserva::atualizarSemTrava(const Reserva& reserva, Reserva* anterior,
+                                                         const unsigned long long* versaoEsperada) {
+    auto it = indice.find(reserva.getCodigo());
+    if (it == indice.end()) return ResultadoAtualizacao::NAO_ENCONTRADO;
+    if (versaoEsperada && it->second->getVersao() != *versaoEsperada) return ResultadoAtualizacao::CONFLITO;
+    if (anterior) *anterior = *it->second;
+    const unsigned long long versao = it->second->getVersao() + 1;
+    if (it->second->getQuarto() != reserva.getQuarto()) {
+        desvincular(porQuarto, it->second->getQuarto(), it->second);
+        vincular(porQuarto, reserva.getQuarto(), it->second);
+    }
+    *it->second = reserva;
+    it->second->setVersao(versao);
+    if (colunas) colunas->atualizar(reserva);
+    return ResultadoAtualizacao::ATUALIZADO;
+}
+
+void ContainerReserva::restaurarSemTrava(const Reserva& reserva) {
+    auto it = indice.find(reserva.getCodigo());
+    if (it == indice.end()) {
+        incluirSemTrava(reserva);
+        container.back().setVersao(reserva.getVersao());
+    } else {
+        atualizarSemTrava(reserva, nullptr, nullptr);
+        it->second->setVersao(reserva.getVersao());
+    }
+}
+
+std::vector<Codigo> ContainerReserva::listarPorQuarto(const Numero& quarto) const {
+    std::shared_lock<std::shared_mutex> bloqueio(trava);
+    std::vector<Codigo> codigos;
+    auto it = porQuarto.find(quarto);
+    if (it == porQuarto.end()) return codigos;
+    codigos.reserve(it->second.size());
+    for (const auto& reserva : it->second) codigos.push_back(reserva->getCodigo());
+    return codigos;
+}
+
+size_t ContainerReserva::removerPorQuarto(const Numero& quarto) {
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    auto it = porQuarto.find(quarto);
+    if (it == porQuarto.end()) return 0;
+
+    // A entrada do índice reverso sai inteira, sem buscas elemento a elemento
+    std::vector<std::list<Reserva>::iterator> reservas = std::move(it->second);
+    porQuarto.erase(it);
+    for (const auto& reserva : reservas) {
+        if (colunas) colunas->remover(reserva->getCodigo());
+        indice.erase(reserva->getCodigo());
+        container.erase(reserva);
+    }
+    return reservas.size();
+}
+
+void ContainerReserva::habilitarColunas() {
+    std::unique_lock<std::shared_mutex> bloqueio(trava);
+    if (colunas) return;
+    colunas.reset(new ColunasReserva());
+    for (const auto& reserva : container) colunas->incluir(reserva);
+}
+
+// ====================================================================
+// IMPLEMENTAÇÃO: ESPELHO COLUNAR DE QUARTOS
+// ====================================================================
+
+void ColunasQuarto::incluir(const Quarto& quarto) {
+    posicao.emplace(quarto.getNumero().getValor(), numeros.size());
+    numeros.push_back(quarto.getNumero().getValor());
+    capacidades.push_back(quarto.getCapacidade().getValor());
+    diarias.push_back(quarto.getDiaria().getCentavos());
+}
+
+void ColunasQuarto::remover(const Numero& numero) {
+    auto it = posicao.find(numero.getValor());
+    if (it == posicao.end()) return;
+    size_t linha = it->second;
+    posicao.erase(it);
+
+    // A última linha ocupa o lugar da removida
+    size_t ultima = numeros.size() - 1;
+    if (linha != ultima) {
+        numeros[linha] = numeros[ultima];
+        capacidades[linha] = capacidades[ultima];
+        diarias[linha] = diarias[ultima];
+        posicao[numeros[linha]] = linha;
+    }
+    numeros.pop_back();
+    capacidades.pop_back();
+    diarias.pop_back();
+}
+
+void ColunasQuarto::atualizar(const Quarto& quarto) {
+    auto it = posicao.find(quarto.getNumero().getValor());
+    if (it == posicao.end()) return;
+    capacidades[it->second] = quarto.getCapacidade().getValor();
+    diarias[it->second] = quarto.getDiaria().getCentavos();
+}
+
+size_t ColunasQuarto::contarPorCapacidade(unsigned short minima) const {
+    size_t total = 0;
+    for (size_t i = 0; i < capacidades.size(); i++) total += (capacidades[i] >= minima);
+    return total;
+}
+
+// ====================================================================
+// IMPLEMENTAÇÃO: ESPELHO COLUNAR DE RESERVAS
+// ====================================================================
+
+void ColunasReserva::incluir(const Reserva& reserva) {
+    posicao.emplace(reserva.getCodigo(), codigos.size());
+    codigos.push_back(reserva.getCodigo());
+    quartos.push_back(reserva.getQuarto().getValor());
+    chegadas.push_back(reserva.getChegada().getSerial());
+    partidas.push_back(reserva.getPartida().getSerial());
+    valores.push_back(reserva.getValor().getCentavos());
+}
+
+void ColunasReserva::remover(const Codigo& codigo) {
+    auto it = posicao.find(codigo);
+    if (it == posicao.end()) return;
+    size_t linha = it->second;
+    posicao.erase(it);
+
+    // A última linha ocupa o lugar da removida
+    size_t ultima = codigos.size() - 1;
+    if (linha != ultima) {
+        codigos[linha] = std::move(codigos[ultima]);
+        quartos[linha] = quartos[ultima];
+        chegadas[linha] = chegadas[ultima];
+        partidas[linha] = partidas[ultima];
+        valores[linha] = valores[ultima];
+        posicao[codigos[linha]] = linha;
+    }
+    codigos.pop_back();
+    quartos.pop_back();
+    chegadas.pop_back();
+    partidas.pop_back();
+    valores.pop_back();
+}
+
+void ColunasReserva::atualizar(const Reserva& reserva) {
+    auto it = posicao.find(reserva.getCodigo());
+    if (it == posicao.end()) return;
+    size_t linha = it->second;
+    quartos[linha] = reserva.getQuarto().getValor();
+    chegadas[linha] = reserva.getChegada().getSerial();
+    partidas[linha] = reserva.getPartida().getSerial();
+    valores[linha] = reserva.getValor().getCentavos();
+}
+
+long long ColunasReserva::somarValores(int inicio, int fim) const {
+    // Sem desvios: a condição vira máscara, permitindo a vetorização do laço
+    long long total = 0;
+    for (size_t i = 0; i < valores.size(); i++) {
+        total += (chegadas[i] >= inicio && chegadas[i] < fim) ? valores[i] : 0;
     }
-    return false;
+    return total;
 }
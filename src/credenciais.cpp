@@ -0,0 +1,243 @@
+#include "credenciais.hpp"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+// ====================================================================
+// IMPLEMENTAÇÃO: SHA-256
+// ====================================================================
+
+namespace {
+
+constexpr uint32_t CONSTANTES[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t rotacionar(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+} // namespace
+
+Sha256::Sha256() : estado{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                          0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+                   bloco{}, usados(0), totalBytes(0) {}
+
+void Sha256::comprimir(const uint8_t* dados) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t(dados[4 * i]) << 24) | (uint32_t(dados[4 * i + 1]) << 16)
+             | (uint32_t(dados[4 * i + 2]) << 8) | uint32_t(dados[4 * i + 3]);
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotacionar(w[i - 15], 7) ^ rotacionar(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotacionar(w[i - 2], 17) ^ rotacionar(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = estado[0], b = estado[1], c = estado[2], d = estado[3];
+    uint32_t e = estado[4], f = estado[5], g = estado[6], h = estado[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = h + (rotacionar(e, 6) ^ rotacionar(e, 11) ^ rotacionar(e, 25))
+                    + ((e & f) ^ (~e & g)) + CONSTANTES[i] + w[i];
+        uint32_t t2 = (rotacionar(a, 2) ^ rotacionar(a, 13) ^ rotacionar(a, 22))
+                    + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    estado[0] += a; estado[1] += b; estado[2] += c; estado[3] += d;
+    estado[4] += e; estado[5] += f; estado[6] += g; estado[7] += h;
+}
+
+void Sha256::atualizar(const void* dados, size_t tamanho) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(dados);
+    totalBytes += tamanho;
+    while (tamanho > 0) {
+        // Blocos completos vão direto da entrada, sem passar pelo buffer
+        if (usados == 0 && tamanho >= 64) {
+            comprimir(bytes);
+            bytes += 64; tamanho -= 64;
+            continue;
+        }
+        size_t copia = min(tamanho, 64 - usados);
+        for (size_t i = 0; i < copia; i++) bloco[usados + i] = bytes[i];
+        usados += copia; bytes += copia; tamanho -= copia;
+        if (usados == 64) { comprimir(bloco); usados = 0; }
+    }
+}
+
+Resumo Sha256::finalizar() {
+    uint64_t bits = totalBytes * 8;
+    uint8_t preenchimento[72] = {0x80};
+    size_t tamanho = (usados < 56 ? 56 - usados : 120 - usados);
+    for (int i = 0; i < 8; i++) preenchimento[tamanho + i] = uint8_t(bits >> (56 - 8 * i));
+    atualizar(preenchimento, tamanho + 8);
+
+    Resumo resumo;
+    for (int i = 0; i < 8; i++) {
+        resumo[4 * i]     = uint8_t(estado[i] >> 24);
+        resumo[4 * i + 1] = uint8_t(estado[i] >> 16);
+        resumo[4 * i + 2] = uint8_t(estado[i] >> 8);
+        resumo[4 * i + 3] = uint8_t(estado[i]);
+    }
+    return resumo;
+}
+
+// ====================================================================
+// IMPLEMENTAÇÃO: DERIVAÇÃO DE SENHAS (BALLOON HASHING)
+// ====================================================================
+
+namespace {
+
+// Contador little-endian de 64 bits que prefixa cada chamada ao hash
+inline void acrescentarContador(Sha256& hash, uint64_t contador) {
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; i++) bytes[i] = uint8_t(contador >> (8 * i));
+    hash.atualizar(bytes, sizeof(bytes));
+}
+
+} // namespace
+
+Resumo DerivadorSenha::derivar(const string& senha, const array<uint8_t, 16>& sal,
+                               uint32_t blocos, uint32_t rodadas) {
+    vector<Resumo> buffer(blocos);
+    uint64_t contador = 0;
+
+    // 1. Expansão: preenche o buffer em sequência a partir da senha e do sal
+    {
+        Sha256 hash;
+        acrescentarContador(hash, contador++);
+        hash.atualizar(senha.data(), senha.size());
+        hash.atualizar(sal.data(), sal.size());
+        buffer[0] = hash.finalizar();
+    }
+    for (uint32_t m = 1; m < blocos; m++) {
+        Sha256 hash;
+        acrescentarContador(hash, contador++);
+        hash.atualizar(buffer[m - 1].data(), buffer[m - 1].size());
+        buffer[m] = hash.finalizar();
+    }
+
+    // 2. Mistura: cada bloco absorve o anterior e VIZINHOS blocos pseudoaleatórios
+    for (uint32_t t = 0; t < rodadas; t++) {
+        for (uint32_t m = 0; m < blocos; m++) {
+            const Resumo& anterior = buffer[(m + blocos - 1) % blocos];
+            {
+                Sha256 hash;
+                acrescentarContador(hash, contador++);
+                hash.atualizar(anterior.data(), anterior.size());
+                hash.atualizar(buffer[m].data(), buffer[m].size());
+                buffer[m] = hash.finalizar();
+            }
+            for (uint32_t i = 0; i < VIZINHOS; i++) {
+                Sha256 escolha;
+                acrescentarContador(escolha, contador++);
+                escolha.atualizar(sal.data(), sal.size());
+                acrescentarContador(escolha, (uint64_t(t) << 32) | m);
+                acrescentarContador(escolha, i);
+                Resumo sorteio = escolha.finalizar();
+
+                uint64_t indice = 0;
+                for (int b = 0; b < 8; b++) indice |= uint64_t(sorteio[b]) << (8 * b);
+                const Resumo& vizinho = buffer[indice % blocos];
+
+                Sha256 hash;
+                acrescentarContador(hash, contador++);
+                hash.atualizar(buffer[m].data(), buffer[m].size());
+                hash.atualizar(vizinho.data(), vizinho.size());
+                buffer[m] = hash.finalizar();
+            }
+        }
+    }
+    return buffer[blocos - 1];
+}
+
+Credencial DerivadorSenha::gerar(const string& senha, uint32_t blocos, uint32_t rodadas) {
+    if (blocos == 0 || rodadas == 0) throw invalid_argument("Custos de derivacao devem ser positivos.");
+
+    thread_local random_device fonte;
+    Credencial credencial;
+    credencial.blocos = blocos;
+    credencial.rodadas = rodadas;
+    for (size_t i = 0; i < credencial.sal.size(); i += 4) {
+        uint32_t bits = fonte();
+        for (size_t j = 0; j < 4; j++) credencial.sal[i + j] = uint8_t(bits >> (8 * j));
+    }
+    credencial.resumo = derivar(senha, credencial.sal, blocos, rodadas);
+    return credencial;
+}
+
+bool DerivadorSenha::conferir(const Credencial& credencial, const string& senha) {
+    if (credencial.vazia()) return false;
+    Resumo calculado = derivar(senha, credencial.sal, credencial.blocos, credencial.rodadas);
+
+    // Tempo constante: percorre todos os bytes, independentemente de onde difiram
+    uint8_t diferenca = 0;
+    for (size_t i = 0; i < calculado.size(); i++) diferenca |= uint8_t(calculado[i] ^ credencial.resumo[i]);
+    return diferenca == 0;
+}
+
+// ====================================================================
+// IMPLEMENTAÇÃO: VERIFICADOR DE SENHAS (POOL LIMITADO)
+// ====================================================================
+
+VerificadorSenhas::VerificadorSenhas(size_t quantidadeThreads, size_t capacidadeFila)
+    : capacidadeFila(capacidadeFila) {
+    if (quantidadeThreads == 0) quantidadeThreads = max(1u, thread::hardware_concurrency() / 2);
+    trabalhadores.reserve(quantidadeThreads);
+    for (size_t i = 0; i < quantidadeThreads; i++) trabalhadores.emplace_back(&VerificadorSenhas::executar, this);
+}
+
+VerificadorSenhas::~VerificadorSenhas() {
+    {
+        lock_guard<mutex> bloqueio(trava);
+        encerrando = true;
+    }
+    temTarefa.notify_all();
+    for (auto& trabalhador : trabalhadores) trabalhador.join();
+}
+
+void VerificadorSenhas::executar() {
+    while (true) {
+        function<void()> tarefa;
+        {
+            unique_lock<mutex> bloqueio(trava);
+            temTarefa.wait(bloqueio, [this] { return encerrando || !fila.empty(); });
+            if (fila.empty()) return; // Encerrando e sem pendências
+            tarefa = std::move(fila.front());
+            fila.pop_front();
+        }
+        tarefa();
+    }
+}
+
+VerificadorSenhas& VerificadorSenhas::instancia() {
+    static VerificadorSenhas verificador;
+    return verificador;
+}
+
+void VerificadorSenhas::enfileirar(function<void()> tarefa) {
+    {
+        lock_guard<mutex> bloqueio(trava);
+        if (fila.size() >= capacidadeFila) throw runtime_error("Servico de autenticacao sobrecarregado.");
+        fila.push_back(std::move(tarefa));
+    }
+    temTarefa.notify_one();
+}
+
+future<bool> VerificadorSenhas::conferir(const Credencial& credencial, const string& senha) {
+    return submeter([credencial, senha] { return DerivadorSenha::conferir(credencial, senha); });
+}
+
+future<Credencial> VerificadorSenhas::gerar(const string& senha, uint32_t blocos, uint32_t rodadas) {
+    return submeter([senha, blocos, rodadas] { return DerivadorSenha::gerar(senha, blocos, rodadas); });
+}
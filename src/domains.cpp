@@ -6,6 +6,9 @@
 #include <vector>
 #include <algorithm>
 #include <cmath> // Para round
+#include <cstdint>
+#include <cstring> // Para memcpy
+#include <mutex>
 
 using namespace std;
 
@@ -14,8 +17,8 @@ using namespace std;
 // ============================================================================
 
 void Numero::validar(int valor) {
-    if(valor < 1 || valor > 999) {
-        throw invalid_argument("Numero invalido. O valor deve estar entre 1 e 999.");
+    if (const char* erro = verificar(valor)) {
+        throw invalid_argument(erro);
     }
 }
 
@@ -24,47 +27,17 @@ void Numero::setValor(int novoValor) {
     this->valor = novoValor;
 }
 
+void Numero::setValor(const Literal<Numero>& literal) {
+    this->valor = literal.getValor();
+}
+
 // ============================================================================
 // CLASSE SENHA
 // ============================================================================
 
 void Senha::validar(const string& valor) {
-    const int TAMANHO = 5;
-
-    if(valor.length() != TAMANHO) {
-        throw invalid_argument("Senha deve conter exatamente 5 caracteres.");
-    }
-
-    bool temDigito = false;
-    bool temMaiuscula = false;
-    bool temMinuscula = false;
-    bool temEspecial = false;
-
-    const string CARACTERES_ESPECIAIS = "!\"#$%&?";
-
-    for(char c : valor) {
-        if (isdigit(c)) temDigito = true;
-        else if (isupper(c)) temMaiuscula = true;
-        else if (islower(c)) temMinuscula = true;
-        else if (CARACTERES_ESPECIAIS.find(c) != string::npos) temEspecial = true;
-        else throw invalid_argument("Caracter invalido na senha.");
-    }
-
-    if(!temDigito || !temMaiuscula || !temMinuscula || !temEspecial) {
-        throw invalid_argument("Senha deve conter pelo menos uma letra minuscula, uma maiuscula, um digito e um caracter especial.");
-    }
-
-    // Verifica caracteres sequenciais repetidos (tipo por tipo)
-    for(size_t i = 0; i < valor.length() - 1; i++) {
-        char atual = valor[i];
-        char proximo = valor[i+1];
-
-        if(isalpha(atual) && isalpha(proximo)) {
-            throw invalid_argument("Letra nao pode ser seguida por letra.");
-        }
-        if(isdigit(atual) && isdigit(proximo)) {
-            throw invalid_argument("Digito nao pode ser seguido por digito.");
-        }
+    if (const char* erro = verificar(valor)) {
+        throw invalid_argument(erro);
     }
 }
 
@@ -73,44 +46,17 @@ void Senha::setValor(const string& novoValor) {
     this->valor = novoValor;
 }
 
+void Senha::setValor(const Literal<Senha>& literal) {
+    this->valor.assign(literal.getValor().data(), literal.getValor().size());
+}
+
 // ============================================================================
 // CLASSE ENDERECO
 // ============================================================================
 
 void Endereco::validar(const string& valor) {
-    const size_t TAMANHO_MIN = 5;
-    const size_t TAMANHO_MAX = 30;
-    const string CARACTERES_ESPECIAIS = ",. ";
-
-    if(valor.length() < TAMANHO_MIN || valor.length() > TAMANHO_MAX) {
-        throw invalid_argument("Endereco deve conter entre 5 e 30 caracteres.");
-    }
-
-    for(size_t i = 0; i < valor.length(); i++) {
-        char c = valor[i];
-
-        if (!(isalnum(c) || CARACTERES_ESPECIAIS.find(c) != string::npos)) {
-            throw invalid_argument("Caracter invalido no endereco.");
-        }
-
-        if((i == 0 || i == valor.length()-1) && CARACTERES_ESPECIAIS.find(c) != string::npos) {
-            throw invalid_argument("Primeiro e ultimo caracter nao pode ser virgula, ponto ou espaco em branco.");
-        }
-    }
-
-    for(size_t i = 0; i < valor.length() - 1; i++) {
-        char atual = valor[i];
-        char proximo = valor[i+1];
-
-        if(atual == ',' && (proximo == ',' || proximo == '.')) {
-            throw invalid_argument("Virgula nao pode ser seguida por virgula ou ponto.");
-        }
-        if(atual == '.' && (proximo == ',' || proximo == '.')) {
-            throw invalid_argument("Ponto nao pode ser seguido por virgula ou ponto.");
-        }
-        if(atual == ' ' && !isalnum(proximo)) {
-            throw invalid_argument("Espaco em branco deve ser seguido por letra ou digito.");
-        }
+    if (const char* erro = verificar(valor)) {
+        throw invalid_argument(erro);
     }
 }
 
@@ -119,13 +65,17 @@ void Endereco::setValor(const string& novoValor) {
     this->valor = novoValor;
 }
 
+void Endereco::setValor(const Literal<Endereco>& literal) {
+    this->valor.assign(literal.getValor().data(), literal.getValor().size());
+}
+
 // ============================================================================
 // CLASSE DINHEIRO
 // ============================================================================
 
 void Dinheiro::validar(long long valor) {
-    if (valor < 1 || valor > 100000000) { // 1 centavo a 1 milhão de reais (em centavos)
-       throw invalid_argument("Valor monetario fora do intervalo permitido (0,01 a 1.000.000,00).");
+    if (const char* erro = verificar(valor)) {
+        throw invalid_argument(erro);
     }
 }
 
@@ -136,42 +86,100 @@ void Dinheiro::setValor(double valor) {
     this->valor = valorEmCentavos;
 }
 
+void Dinheiro::setValor(string_view texto) {
+    long long reais = 0;
+    size_t i = 0;
+
+    while (i < texto.size() && texto[i] >= '0' && texto[i] <= '9') {
+        reais = reais * 10 + (texto[i] - '0');
+        if (reais > MAXIMO / 100) {
+            throw invalid_argument("Valor monetario fora do intervalo permitido (0,01 a 1.000.000,00).");
+        }
+        i++;
+    }
+    if (i == 0) throw invalid_argument("Valor monetario deve iniciar com digito.");
+
+    long long centavos = 0;
+    if (i < texto.size()) {
+        if (texto[i] != '.' && texto[i] != ',')
+            throw invalid_argument("Valor monetario invalido. Use o formato 0000.00.");
+        i++;
+
+        size_t casas = texto.size() - i;
+        if (casas < 1 || casas > 2)
+            throw invalid_argument("Valor monetario deve ter 1 ou 2 casas decimais.");
+
+        for (; i < texto.size(); i++) {
+            if (texto[i] < '0' || texto[i] > '9')
+                throw invalid_argument("Valor monetario invalido. Use o formato 0000.00.");
+            centavos = centavos * 10 + (texto[i] - '0');
+        }
+        if (casas == 1) centavos *= 10;
+    }
+
+    setCentavos(reais * 100 + centavos);
+}
+
+void Dinheiro::setCentavos(long long centavos) {
+    validar(centavos);
+    this->valor = centavos;
+}
+
+void Dinheiro::setValor(const Literal<Dinheiro>& literal) {
+    this->valor = literal.getValor();
+}
+
 double Dinheiro::getValor() const {
     return static_cast<double>(valor) / 100.0;
 }
 
-// ============================================================================
-// CLASSE CARTAO
-// ============================================================================
+string Dinheiro::formatar() const {
+    string centavos = to_string(valor % 100);
+    if (centavos.size() == 1) centavos.insert(0, 1, '0');
+    return to_string(valor / 100) + "." + centavos;
+}
 
-void Cartao::validar(const string& valor){
-    if(valor.size() != 16)
-        throw invalid_argument("O numero do cartao deve conter exatamente 16 digitos.");
+Dinheiro Dinheiro::operator+(const Dinheiro& outro) const {
+    Dinheiro soma;
+    soma.setCentavos(valor + outro.valor);
+    return soma;
+}
 
-    for(char c : valor){
-        if(!isdigit(c))
-            throw invalid_argument("O cartao deve conter apenas digitos (0-9).");
+Dinheiro Dinheiro::operator*(unsigned int quantidade) const {
+    // Verifica antes de multiplicar para não estourar o long long
+    if (quantidade > static_cast<unsigned long long>(MAXIMO)) {
+        throw invalid_argument("Valor monetario fora do intervalo permitido (0,01 a 1.000.000,00).");
     }
+    Dinheiro produto;
+    produto.setCentavos(valor * static_cast<long long>(quantidade));
+    return produto;
+}
 
-    // Algoritmo de Luhn
-    int soma = 0;
-    for(int i = 14; i >= 0; i--){
-        int digito = valor[i] - '0';
+Dinheiro Dinheiro::escalar(long long pontosBase) const {
+    // Arredondamento half-up: soma metade do divisor antes da divisão inteira
+    long long fator = 10000 + pontosBase;
+    Dinheiro resultado;
+    resultado.setCentavos((valor * fator + 5000) / 10000);
+    return resultado;
+}
 
-        // O algoritmo dobra alternadamente, começando do penúltimo (índice par se considerarmos 0-based da direita, ou ímpar da esquerda se tamanho par)
-        // Como size é 16 (par), índices pares (0, 2... 14) são os que dobram.
-        if(i % 2 == 0) {
-            digito *= 2;
-            if(digito > 9) digito -= 9;
-        }
-        soma += digito;
-    }
+Dinheiro Dinheiro::aplicarDesconto(unsigned int pontosBase) const {
+    if (pontosBase > 10000) throw invalid_argument("Desconto nao pode exceder 100%.");
+    return escalar(-static_cast<long long>(pontosBase));
+}
 
-    int digitoVerificadorCalculado = (10 - (soma % 10)) % 10;
-    int digitoVerificadorReal = valor[15] - '0';
+Dinheiro Dinheiro::aplicarAcrescimo(unsigned int pontosBase) const {
+    return escalar(static_cast<long long>(pontosBase));
+}
 
-    if(digitoVerificadorCalculado != digitoVerificadorReal)
-        throw invalid_argument("Numero do cartao invalido (falha no algoritmo de Luhn).");
+// ============================================================================
+// CLASSE CARTAO
+// ============================================================================
+
+void Cartao::validar(const string& valor) {
+    if (const char* erro = verificar(valor)) {
+        throw invalid_argument(erro);
+    }
 }
 
 void Cartao::setValor(const string& valor){
@@ -179,40 +187,17 @@ void Cartao::setValor(const string& valor){
     this->valor = valor;
 }
 
+void Cartao::setValor(const Literal<Cartao>& literal){
+    this->valor.assign(literal.getValor().data(), literal.getValor().size());
+}
+
 // ============================================================================
 // CLASSE NOME
 // ============================================================================
 
-void Nome::validar(const string& valor){
-    if(valor.size() < 5 || valor.size() > 20)
-        throw invalid_argument("Nome deve conter entre 5 e 20 caracteres.");
-
-    // O HPP define que precisamos de validações, vamos garantir algumas básicas
-    // Mas respeitando o código original da equipe que estava bom:
-
-    if(valor.back() == ' ')
-        throw invalid_argument("Ultimo caractere nao deve ser espaco em branco.");
-
-    // Verifica caractere inicial
-    if(!isupper(valor[0]))
-        throw invalid_argument("Primeiro caractere deve ser letra maiuscula.");
-
-    bool espacoAnterior = false;
-    for(size_t i = 0; i < valor.size(); i++){
-        char c = valor[i];
-
-        if (c == ' ') {
-            if (espacoAnterior) throw invalid_argument("Nao pode haver espacos seguidos.");
-            espacoAnterior = true;
-            continue;
-        }
-
-        if (espacoAnterior) {
-            if (!isupper(c)) throw invalid_argument("Primeiro caractere de cada termo deve ser maiusculo.");
-            espacoAnterior = false;
-        } else {
-            if (!isalpha(c) && c != ' ') throw invalid_argument("Nome deve conter apenas letras e espacos.");
-        }
+void Nome::validar(const string& valor) {
+    if (const char* erro = verificar(valor)) {
+        throw invalid_argument(erro);
     }
 }
 
@@ -221,13 +206,18 @@ void Nome::setValor(const string& valor){
     this->valor = valor;
 }
 
+void Nome::setValor(const Literal<Nome>& literal){
+    this->valor.assign(literal.getValor().data(), literal.getValor().size());
+}
+
 // ============================================================================
 // CLASSE CAPACIDADE
 // ============================================================================
 
 void Capacidade::validar(unsigned short capacidade) const {
-    if (capacidade < 1 || capacidade > 4)
-        throw invalid_argument("Capacidade deve ser 1, 2, 3 ou 4.");
+    if (const char* erro = verificar(capacidade)) {
+        throw invalid_argument(erro);
+    }
 }
 
 void Capacidade::setValor(unsigned short capacidade) {
@@ -235,70 +225,68 @@ void Capacidade::setValor(unsigned short capacidade) {
     this->capacidade = capacidade;
 }
 
+void Capacidade::setValor(const Literal<Capacidade>& literal) {
+    this->capacidade = literal.getValor();
+}
+
 // ============================================================================
 // CLASSE DATA
 // ============================================================================
 
-string Data::letraMaiuscula(const string &s) const {
-    string convertida = s;
-    for (char &c : convertida) {
-        c = toupper(c);
-    }
-    return convertida;
-}
-
-unsigned short Data::mesParaIndice(const string &mes) const {
-    string m = letraMaiuscula(mes);
-    if (m == "JAN") return 1;
-    if (m == "FEV") return 2;
-    if (m == "MAR") return 3;
-    if (m == "ABR") return 4;
-    if (m == "MAI") return 5;
-    if (m == "JUN") return 6;
-    if (m == "JUL") return 7;
-    if (m == "AGO") return 8;
-    if (m == "SET") return 9;
-    if (m == "OUT") return 10;
-    if (m == "NOV") return 11;
-    if (m == "DEZ") return 12;
-    return 0;
-}
-
-bool Data::ehBissexto(unsigned short ano) const {
-    return (ano % 4 == 0 && (ano % 100 != 0 || ano % 400 == 0));
-}
-
-unsigned short Data::diasNoMes(const string &mes, unsigned short ano) const {
-    unsigned short indice = mesParaIndice(mes);
-    switch (indice) {
-        case 1: case 3: case 5: case 7: case 8: case 10: case 12: return 31;
-        case 4: case 6: case 9: case 11: return 30;
-        case 2: return ehBissexto(ano) ? 29 : 28;
-        default: return 0;
+void Data::validar(unsigned short dia, string_view mes, unsigned short ano) {
+    if (const char* erro = verificar(dia, mes, ano)) {
+        throw invalid_argument(erro);
     }
 }
 
-bool Data::mesValido(const string &mes) const {
-    return mesParaIndice(mes) != 0;
+void Data::atribuir(unsigned short dia, unsigned short indiceMes, unsigned short ano) {
+    this->dia = dia;
+    this->indiceMes = indiceMes;
+    this->mes = string(NOMES_MESES[indiceMes - 1]);
+    this->ano = ano;
+    this->serial = Calendario::paraSerial(dia, indiceMes, ano);
+}
+
+void Data::setValor(unsigned short dia, const string &mes, unsigned short ano) {
+    validar(dia, mes, ano);
+    atribuir(dia, mesParaIndice(mes), ano);
+}
+
+void Data::setValor(const Literal<Data>& literal) {
+    atribuir(literal.getDia(), mesParaIndice(literal.getMes()), literal.getAno());
 }
 
-void Data::validar(unsigned short dia, const string &mes, unsigned short ano) const {
-    if (ano < ANO_MIN || ano > ANO_MAX)
+void Data::setSerial(int serial) {
+    if (serial < 0 || serial > Calendario::ultimoSerial())
         throw invalid_argument("Ano fora do intervalo permitido (2000-2999).");
 
-    if (!mesValido(mes))
-        throw invalid_argument("Mes invalido. Use JAN, FEV, MAR, etc.");
+    unsigned short novoDia = 0, novoMes = 0, novoAno = 0;
+    Calendario::deSerial(serial, novoDia, novoMes, novoAno);
+    atribuir(novoDia, novoMes, novoAno);
+}
 
-    unsigned short limite = diasNoMes(mes, ano);
-    if (dia < 1 || dia > limite)
-        throw invalid_argument("Dia invalido para o mes e ano informados.");
+Data Data::somarDias(int dias) const {
+    Data resultado;
+    resultado.setSerial(serial + dias);
+    return resultado;
 }
 
-void Data::setValor(unsigned short dia, const string &mes, unsigned short ano) {
-    validar(dia, mes, ano);
-    this->dia = dia;
-    this->mes = letraMaiuscula(mes);
-    this->ano = ano;
+// Mês e ano vêm do serial, como em somarDias: numa Data não definida, indiceMes
+// e ano são 0 (fora das tabelas), mas o serial 0 é 01-JAN-2000
+Data Data::primeiroDiaDoMes() const {
+    unsigned short diaSerial = 0, mesSerial = 0, anoSerial = 0;
+    Calendario::deSerial(serial, diaSerial, mesSerial, anoSerial);
+    Data resultado;
+    resultado.atribuir(1, mesSerial, anoSerial);
+    return resultado;
+}
+
+Data Data::ultimoDiaDoMes() const {
+    unsigned short diaSerial = 0, mesSerial = 0, anoSerial = 0;
+    Calendario::deSerial(serial, diaSerial, mesSerial, anoSerial);
+    Data resultado;
+    resultado.atribuir(Calendario::diasNoMes(mesSerial, anoSerial), mesSerial, anoSerial);
+    return resultado;
 }
 
 // ============================================================================
@@ -306,22 +294,8 @@ void Data::setValor(unsigned short dia, const string &mes, unsigned short ano) {
 // ============================================================================
 
 void Telefone::validar(const string &telefone) {
-    if (telefone.empty() || telefone[0] != '+')
-        throw invalid_argument("Telefone deve comecar com '+'.");
-
-    // +DDDDDDDDDDDDDD (15 chars: + e 14 dígitos) ou 16 chars se for + e 15 dígitos?
-    // O documento diz "+DDDDDDDDDDDDDD" com D sendo digito.
-    // Se contar os D's no exemplo visual do PDF, as vezes parece ter 14 ou 15.
-    // Mas a tabela diz "Telefone: +DDDDDDDDDDDDDD".
-    // Vamos assumir a validação do código original da equipe que pedia 16 chars totais.
-
-    // Assumindo + e 15 digitos = 16 chars.
-    if (telefone.size() != 16)
-        throw invalid_argument("Telefone deve ter formato + e 15 digitos (Total 16 chars).");
-
-    for (size_t i = 1; i < telefone.size(); i++) {
-        if (!isdigit(telefone[i]))
-            throw invalid_argument("Telefone deve conter apenas digitos apos o '+'.");
+    if (const char* erro = verificar(telefone)) {
+        throw invalid_argument(erro);
     }
 }
 
@@ -330,19 +304,17 @@ void Telefone::setValor(const string &novoValor) {
     this->telefone = novoValor;
 }
 
+void Telefone::setValor(const Literal<Telefone>& literal) {
+    this->telefone.assign(literal.getValor().data(), literal.getValor().size());
+}
+
 // ============================================================================
 // CLASSE CODIGO
 // ============================================================================
 
 void Codigo::validar(const string& codigo) {
-    if(codigo.length() != 10) {
-        throw invalid_argument("Codigo deve ter 10 caracteres.");
-    }
-
-    for(char c : codigo) {
-        if(!isalnum(c)) {
-            throw invalid_argument("Codigo deve conter apenas letras e numeros.");
-        }
+    if (const char* erro = verificar(codigo)) {
+        throw invalid_argument(erro);
     }
 }
 
@@ -351,77 +323,108 @@ void Codigo::setValor(const string& novoValor) {
     this->codigo = novoValor;
 }
 
+void Codigo::setValor(const Literal<Codigo>& literal) {
+    this->codigo.assign(literal.getValor().data(), literal.getValor().size());
+}
+
 // ============================================================================
 // CLASSE EMAIL
 // ============================================================================
 
-void EMAIL::validar(const string& email) {
-    // Verifica estrutura básica
-    size_t posArroba = email.find("@");
-    if(posArroba == string::npos) {
-        throw invalid_argument("Email deve conter '@'.");
+void EMAIL::validar(string_view email) {
+    if (const char* erro = verificar(email)) {
+        throw invalid_argument(erro);
     }
+}
 
-    string parte_local = email.substr(0, posArroba);
-    string dominio = email.substr(posArroba + 1);
-
-    if(parte_local.length() > MAX_PARTE_LOCAL) throw invalid_argument("Parte local muito longa.");
-    if(dominio.length() > MAX_DOMINIO) throw invalid_argument("Dominio muito longo.");
-
-    // Validação Parte Local
-    // Pode conter letra, digito, ponto ou hifen. Não pode iniciar/terminar com ponto/hifen.
-    if(parte_local.empty()) throw invalid_argument("Parte local vazia.");
-
-    if(parte_local.front() == '.' || parte_local.front() == '-')
-        throw invalid_argument("Parte local nao pode iniciar com ponto ou hifen.");
-    if(parte_local.back() == '.' || parte_local.back() == '-')
-        throw invalid_argument("Parte local nao pode terminar com ponto ou hifen.");
-
-    bool anteriorPontoOuHifen = false;
-    for(char c : parte_local) {
-        if (c == '.' || c == '-') {
-            if(anteriorPontoOuHifen) throw invalid_argument("Ponto ou hifen nao podem ser consecutivos.");
-            anteriorPontoOuHifen = true;
-        } else if (isalnum(c)) {
-            anteriorPontoOuHifen = false;
-        } else {
-            throw invalid_argument("Caractere invalido na parte local do email.");
-        }
+void EMAIL::normalizar(char* texto, size_t tamanho) {
+    // Após a validação o texto é ASCII: basta somar 0x20 aos bytes maiúsculos.
+    size_t i = 0;
+    for(; i + 8 <= tamanho; i += 8) {
+        uint64_t bloco = carregarBloco(texto + i);
+        bloco |= bytesMaiusculos(bloco) >> 2;
+        for (int k = 0; k < 8; k++) texto[i + k] = static_cast<char>(bloco >> (8 * k));
+    }
+    for(; i < tamanho; i++) {
+        if(texto[i] >= 'A' && texto[i] <= 'Z') texto[i] += 'a' - 'A';
     }
+}
 
-    // Validação Domínio
-    // Partes separadas por ponto. Não hifen inicio/fim.
-    if(dominio.empty()) throw invalid_argument("Dominio vazio.");
-
-    if(dominio.front() == '-') throw invalid_argument("Dominio nao pode iniciar com hifen.");
-    if(dominio.back() == '-') throw invalid_argument("Dominio nao pode terminar com hifen.");
-
-    // O domínio deve ter pelo menos um ponto separando partes? O PDF diz "composto por uma ou mais partes separadas por ponto".
-    // Se for só "com", é uma parte. Se for "com.br", duas.
-    // Mas não pode iniciar ou terminar com ponto.
-
-    if(dominio.front() == '.' || dominio.back() == '.')
-        throw invalid_argument("Dominio nao pode iniciar ou terminar com ponto.");
-
-    anteriorPontoOuHifen = false;
-    for(char c : dominio) {
-        if (c == '.') {
-            if(anteriorPontoOuHifen) throw invalid_argument("Pontos nao podem ser consecutivos no dominio.");
-            anteriorPontoOuHifen = true;
-        } else if (c == '-') {
-             // Hifen no meio é ok, mas hifen seguido de ponto? "a-.b"?
-             // PDF: "não pode iniciar ou terminar com hifen".
-        } else if (!isalnum(c)) {
-             throw invalid_argument("Caractere invalido no dominio.");
-        }
+void EMAIL::setValor(string_view novoValor) {
+    validar(novoValor);
+    atribuir(novoValor);
+}
+
+void EMAIL::setValor(const Literal<EMAIL>& literal) {
+    atribuir(literal.getValor());
+}
+
+void EMAIL::atribuir(string_view novoValor) {
+    size_t posArroba = novoValor.find('@');
+    string_view local = novoValor.substr(0, posArroba);
+    string_view textoDominio = novoValor.substr(posArroba + 1);
+
+    // O domínio (até 255 caracteres) é normalizado na pilha antes do internamento
+    char bufferDominio[MAX_DOMINIO];
+    memcpy(bufferDominio, textoDominio.data(), textoDominio.size());
+    normalizar(bufferDominio, textoDominio.size());
+
+    // Só consulta a tabela: quem armazena o valor decide internar o domínio
+    const string_view normalizado(bufferDominio, textoDominio.size());
+    this->dominio = TabelaDominios::instancia().procurar(normalizado);
+    this->tamanhoLocal = static_cast<unsigned char>(local.size());
+    this->texto.assign(local.data(), local.size());
+    normalizar(&this->texto[0], this->texto.size());
+    if (!internado()) this->texto.append(1, '@').append(normalizado.data(), normalizado.size());
+}
+
+void EMAIL::internar() {
+    if (internado()) return;
+    this->dominio = TabelaDominios::instancia().internar(getDominio());
+    this->texto.resize(tamanhoLocal);
+    this->texto.shrink_to_fit(); // Devolve a memória do domínio
+}
+
+// ============================================================================
+// CLASSE TABELADOMINIOS
+// ============================================================================
 
-        if (c != '.') anteriorPontoOuHifen = false;
+TabelaDominios::TabelaDominios() {
+    inserir(""); // Id 0: domínio vazio
+}
+
+uint32_t TabelaDominios::inserir(string_view dominio) {
+    uint32_t id = quantidade.load(memory_order_relaxed);
+    if (id == TAMANHO_BLOCO * MAXIMO_BLOCOS) throw length_error("Tabela de dominios cheia.");
+    unique_ptr<Entrada[]>& bloco = blocos[id / TAMANHO_BLOCO];
+    if (!bloco) bloco.reset(new Entrada[TAMANHO_BLOCO]);
+
+    Entrada& nova = bloco[id % TAMANHO_BLOCO];
+    nova.texto.assign(dominio.data(), dominio.size());
+    nova.resumo = hash<string_view>()(nova.texto);
+    indice.emplace(nova.texto, id);
+    quantidade.store(id + 1, memory_order_release);
+    return id;
+}
+
+uint32_t TabelaDominios::internar(string_view dominio) {
+    {
+        shared_lock<shared_mutex> leitura(mutex);
+        auto it = indice.find(dominio);
+        if (it != indice.end()) return it->second;
     }
+
+    unique_lock<shared_mutex> escrita(mutex);
+    // Outra thread pode ter inserido o domínio entre a liberação e a aquisição
+    auto it = indice.find(dominio);
+    if (it != indice.end()) return it->second;
+    return inserir(dominio);
 }
 
-void EMAIL::setValor(const string& novoValor) {
-    validar(novoValor);
-    this->email = novoValor;
+uint32_t TabelaDominios::procurar(string_view dominio) const {
+    shared_lock<shared_mutex> leitura(mutex);
+    auto it = indice.find(dominio);
+    return it == indice.end() ? NAO_INTERNADO : it->second;
 }
 
 // ============================================================================
@@ -429,8 +432,8 @@ void EMAIL::setValor(const string& novoValor) {
 // ============================================================================
 
 void Ramal::validar(unsigned short ramal) {
-    if(ramal > 50) { // Como é unsigned, < 0 não precisa checar
-        throw invalid_argument("Ramal deve estar entre 0 e 50.");
+    if (const char* erro = verificar(ramal)) {
+        throw invalid_argument(erro);
     }
 }
 
@@ -438,3 +441,7 @@ void Ramal::setValor(unsigned short novoValor) {
     validar(novoValor);
     this->ramal = novoValor;
 }
+
+void Ramal::setValor(const Literal<Ramal>& literal) {
+    this->ramal = literal.getValor();
+}
\ No newline at end of file
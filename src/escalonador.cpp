@@ -0,0 +1,186 @@
+#include "escalonador.hpp"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+// ====================================================================
+// IMPLEMENTAÇÃO: ESCALONADOR
+// ====================================================================
+
+namespace {
+
+// Identifica o trabalhador que executa a thread atual (nullptr fora do pool)
+thread_local const Escalonador* escalonadorAtual = nullptr;
+thread_local size_t filaAtual = 0;
+
+} // namespace
+
+Escalonador::Escalonador(size_t quantidadeThreads) {
+    if (quantidadeThreads == 0) quantidadeThreads = max(1u, thread::hardware_concurrency());
+    filas.reserve(quantidadeThreads);
+    for (size_t i = 0; i < quantidadeThreads; i++) filas.push_back(make_unique<Fila>());
+    trabalhadores.reserve(quantidadeThreads);
+    for (size_t i = 0; i < quantidadeThreads; i++) trabalhadores.emplace_back(&Escalonador::executar, this, i);
+}
+
+Escalonador::~Escalonador() {
+    encerrar(ModoEncerramento::CONCLUIR);
+}
+
+void Escalonador::enfileirar(function<void()> tarefa, Prioridade prioridade) {
+    const bool interna = (escalonadorAtual == this);
+    {
+        // Contada sob travaSono: nenhum trabalhador decide parar entre o teste e a inclusão
+        lock_guard<mutex> bloqueio(travaSono);
+        if (encerrando && !interna) throw runtime_error("Escalonador encerrado.");
+        pendentes.fetch_add(1);
+    }
+
+    size_t indice;
+    if (interna) {
+        indice = filaAtual; // Subtarefa: fica com quem a gerou
+    } else {
+        indice = proximaFila.fetch_add(1, memory_order_relaxed) % filas.size();
+    }
+    {
+        lock_guard<mutex> bloqueio(filas[indice]->trava);
+        filas[indice]->tarefas[static_cast<size_t>(prioridade)].push_back(std::move(tarefa));
+    }
+    acordar.notify_one();
+}
+
+bool Escalonador::obterTarefa(size_t indice, function<void()>& tarefa) {
+    for (size_t nivel = 0; nivel < NIVEIS; nivel++) {
+        // 1. Própria fila, pela tarefa mais antiga
+        {
+            deque<function<void()>>& propria = filas[indice]->tarefas[nivel];
+            lock_guard<mutex> bloqueio(filas[indice]->trava);
+            if (!propria.empty()) {
+                tarefa = std::move(propria.front());
+                propria.pop_front();
+                return true;
+            }
+        }
+
+        // 2. Roubo: tarefas mais antigas das filas dos outros, começando pela vizinha
+        for (size_t passo = 1; passo < filas.size(); passo++) {
+            Fila& vitima = *filas[(indice + passo) % filas.size()];
+            lock_guard<mutex> bloqueio(vitima.trava);
+            if (!vitima.tarefas[nivel].empty()) {
+                tarefa = std::move(vitima.tarefas[nivel].front());
+                vitima.tarefas[nivel].pop_front();
+                roubadas.fetch_add(1, memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void Escalonador::executar(size_t indice) {
+    escalonadorAtual = this;
+    filaAtual = indice;
+
+    function<void()> tarefa;
+    while (true) {
+        if (obterTarefa(indice, tarefa)) {
+            pendentes.fetch_sub(1);
+            tarefa(); // packaged_task guarda exceções no futuro
+            tarefa = nullptr;
+            executadas.fetch_add(1, memory_order_relaxed);
+            continue;
+        }
+
+        unique_lock<mutex> bloqueio(travaSono);
+        acordar.wait(bloqueio, [this] { return encerrando || pendentes.load() > 0; });
+        if (encerrando && pendentes.load() == 0) return;
+    }
+}
+
+void Escalonador::paraCada(size_t quantidade, const function<void(size_t)>& funcao, Prioridade prioridade) {
+    if (quantidade == 0) return;
+
+    // Compartilhado com as tarefas auxiliares, que podem começar depois do retorno
+    // (nesse caso não encontram índices livres e não tocam em funcao)
+    struct Estado {
+        atomic<size_t> proximo{0};
+        size_t quantidade = 0;
+        const function<void(size_t)>* funcao = nullptr;
+        mutex trava;
+        condition_variable fim;
+        size_t concluidos = 0;
+        exception_ptr erro;
+    };
+    auto estado = make_shared<Estado>();
+    estado->quantidade = quantidade;
+    estado->funcao = &funcao;
+
+    auto trabalhar = [](Estado& e) {
+        size_t feitos = 0;
+        exception_ptr erro;
+        for (size_t i; (i = e.proximo.fetch_add(1)) < e.quantidade; feitos++) {
+            try {
+                (*e.funcao)(i);
+            } catch (...) {
+                if (!erro) erro = current_exception();
+            }
+        }
+        if (feitos == 0) return;
+        lock_guard<mutex> bloqueio(e.trava);
+        e.concluidos += feitos;
+        if (erro && !e.erro) e.erro = erro;
+        if (e.concluidos == e.quantidade) e.fim.notify_all();
+    };
+
+    const size_t auxiliares = min(quantidade - 1, getQuantidadeThreads());
+    for (size_t i = 0; i < auxiliares; i++) {
+        try {
+            enfileirar([estado, trabalhar] { trabalhar(*estado); }, prioridade);
+        } catch (const runtime_error&) {
+            break; // Encerrado: a própria chamadora cobre os índices restantes
+        }
+    }
+
+    trabalhar(*estado);
+    unique_lock<mutex> bloqueio(estado->trava);
+    estado->fim.wait(bloqueio, [&] { return estado->concluidos == estado->quantidade; });
+    if (estado->erro) rethrow_exception(estado->erro);
+}
+
+void Escalonador::encerrar(ModoEncerramento modo) {
+    lock_guard<mutex> serie(travaEncerramento);
+    if (trabalhadores.empty()) return; // Já encerrado
+    {
+        lock_guard<mutex> bloqueio(travaSono);
+        encerrando = true;
+    }
+
+    if (modo == ModoEncerramento::DESCARTAR) {
+        vector<function<void()>> descartes;
+        for (auto& fila : filas) {
+            lock_guard<mutex> bloqueio(fila->trava);
+            for (auto& tarefas : fila->tarefas) {
+                for (auto& tarefa : tarefas) descartes.push_back(std::move(tarefa));
+                tarefas.clear();
+            }
+        }
+        pendentes.fetch_sub(descartes.size());
+        descartadas.fetch_add(descartes.size(), memory_order_relaxed);
+        descartes.clear(); // Destruir as packaged_task avisa os futuros (broken_promise)
+    }
+
+    acordar.notify_all();
+    for (auto& trabalhador : trabalhadores) trabalhador.join();
+    trabalhadores.clear();
+}
+
+EstatisticasEscalonador Escalonador::getEstatisticas() const {
+    EstatisticasEscalonador estatisticas;
+    estatisticas.executadas = executadas.load(memory_order_relaxed);
+    estatisticas.roubadas = roubadas.load(memory_order_relaxed);
+    estatisticas.descartadas = descartadas.load(memory_order_relaxed);
+    return estatisticas;
+}
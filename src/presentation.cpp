@@ -1,4 +1,5 @@
 #include "presentation.hpp"
+#include <future>
 #include <iostream>
 #include <stdexcept>
 #include <limits>
@@ -11,6 +12,9 @@ using namespace std;
 // FUNÇÕES UTILITÁRIAS
 // ====================================================================
 
+// Origem informada ao limite de tentativas: os logins deste terminal contam juntos
+const string ORIGEM_CONSOLE = "console";
+
 void limparBuffer() {
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
 }
@@ -21,32 +25,71 @@ void esperarEnter() {
     cin.get();
 }
 
+// Formata centavos acima do limite de Dinheiro (totais de relatórios)
+string formatarCentavos(long long centavos) {
+    return to_string(centavos / 100) + "." + (centavos % 100 < 10 ? "0" : "") + to_string(centavos % 100);
+}
+
 // ====================================================================
 // 1. IMPLEMENTAÇÃO: CONTROLADORA DE AUTENTICAÇÃO (MAA)
 // ====================================================================
 
-bool CntrMAAutenticacao::autenticar(EMAIL& email) {
+bool CntrMAAutenticacao::lerCredenciais(EMAIL& email, Senha& senha) {
     string emailStr, senhaStr;
     cout << "\n--- LOGIN ---\n";
     cout << "Email: "; cin >> emailStr;
     cout << "Senha: "; cin >> senhaStr;
 
     try {
-        EMAIL domEmail; domEmail.setValor(emailStr);
-        Senha domSenha; domSenha.setValor(senhaStr);
+        email.setValor(emailStr);
+        senha.setValor(senhaStr);
+        return true;
+    } catch (const exception& e) {
+        cout << "ERRO FORMATO: " << e.what() << endl;
+        return false;
+    }
+}
+
+bool CntrMAAutenticacao::autenticar(EMAIL& email) {
+    EMAIL domEmail; Senha domSenha;
+    if (!lerCredenciais(domEmail, domSenha)) return false;
 
-        if (servicoAutenticacao->autenticar(domEmail, domSenha)) {
+    try {
+        if (servicoAutenticacao->autenticar(domEmail, domSenha, ORIGEM_CONSOLE)) {
             cout << "SUCESSO: Bem-vindo!\n";
             email = domEmail;
             return true;
-        } else {
-            cout << "FALHA: Credenciais invalidas.\n";
-            return false;
         }
     } catch (const exception& e) {
-        cout << "ERRO FORMATO: " << e.what() << endl;
+        cout << "ERRO: " << e.what() << endl;
         return false;
     }
+    cout << "FALHA: Credenciais invalidas.\n";
+    return false;
+}
+
+bool CntrMAAutenticacao::autenticar(EMAIL& email, string& token) {
+    EMAIL domEmail; Senha domSenha;
+    if (!lerCredenciais(domEmail, domSenha)) return false;
+
+    string novoToken;
+    try {
+        // A senha é conferida nas threads de verificação; o console só espera o resultado
+        future<string> pedido = servicoSessao->abrirSessaoAssincrona(domEmail, domSenha, ORIGEM_CONSOLE);
+        cout << "Verificando credenciais...\n";
+        novoToken = pedido.get();
+    } catch (const exception& e) {
+        cout << "ERRO: " << e.what() << endl;
+        return false;
+    }
+    if (!novoToken.empty()) {
+        cout << "SUCESSO: Bem-vindo!\n";
+        email = domEmail;
+        token = novoToken;
+        return true;
+    }
+    cout << "FALHA: Credenciais invalidas.\n";
+    return false;
 }
 
 bool CntrMAAutenticacao::cadastrar() {
@@ -107,7 +150,7 @@ void CntrMAPessoal::executar(const EMAIL& email) {
                     cout << "Nome:  " << g.getNome().getValor() << endl;
                     cout << "Email: " << g.getEmail().getValor() << endl;
                     cout << "Ramal: " << g.getRamal().getValor() << endl;
-                    cout << "Senha: " << g.getSenha().getValor() << endl;
+                    cout << "Senha: (armazenada apenas como hash)" << endl;
                 } catch (...) {
                     cout << "Erro ao recuperar dados do perfil." << endl;
                 }
@@ -202,7 +245,7 @@ void CntrMAPessoal::editarPerfil(const EMAIL& email) {
 
 void CntrMAReserva::executar(const EMAIL& email) {
     int opcao = 0;
-    while (opcao != 5) {
+    while (opcao != 6) {
         cout << "\n=========================================\n";
         cout << "      GESTÃO DE RESERVAS E HOTEL         \n";
         cout << "=========================================\n";
@@ -210,7 +253,8 @@ void CntrMAReserva::executar(const EMAIL& email) {
         cout << "2 - Gerenciar Hoteis\n";
         cout << "3 - Gerenciar Quartos\n";
         cout << "4 - Gerenciar Hospedes\n";
-        cout << "5 - Voltar ao Menu Principal\n";
+        cout << "5 - Relatorio de Ocupacao\n";
+        cout << "6 - Voltar ao Menu Principal\n";
         cout << "Selecione: ";
         cin >> opcao;
 
@@ -221,7 +265,8 @@ void CntrMAReserva::executar(const EMAIL& email) {
             case 2: menuHoteis(); break;
             case 3: menuQuartos(); break;
             case 4: menuHospedes(); break;
-            case 5: break;
+            case 5: menuRelatorio(); break;
+            case 6: break;
             default: cout << "Opcao invalida." << endl;
         }
     }
@@ -248,18 +293,22 @@ void CntrMAReserva::menuReservas() {
             case 1: {
                 try {
                     Reserva r;
-                    string codStr, valStr, dI, mI, aI, dF, mF, aF;
-                    Codigo cod; Data ini; Data fim; Dinheiro val;
+                    string codStr, numStr, dI, mI, aI, dF, mF, aF;
+                    Codigo cod; Numero num; Data ini; Data fim;
 
                     cout << "Codigo (10 carac): "; cin >> codStr; cod.setValor(codStr);
+                    cout << "Quarto (Numero): "; cin >> numStr; num.setValor(stoi(numStr));
                     cout << "Chegada (DD MMM AAAA): "; cin >> dI >> mI >> aI; ini.setValor(stoi(dI), mI, stoi(aI));
                     cout << "Partida (DD MMM AAAA): "; cin >> dF >> mF >> aF; fim.setValor(stoi(dF), mF, stoi(aF));
-                    cout << "Valor (00.00): "; cin >> valStr; val.setValor(stod(valStr));
 
-                    r.setCodigo(cod); r.setChegada(ini); r.setPartida(fim); r.setValor(val);
+                    // Prévia do valor; o serviço recalcula pelo motor tarifário ao gravar
+                    Dinheiro val = servicoReserva->cotarReserva(num, ini, fim);
+                    cout << "Valor da estadia: " << val.formatar() << endl;
+
+                    r.setCodigo(cod); r.setQuarto(num); r.setChegada(ini); r.setPartida(fim);
 
                     if(servicoReserva->criarReserva(r)) cout << "SUCESSO: Reserva criada.\n";
-                    else cout << "FALHA: Codigo duplicado ou conflito de datas.\n";
+                    else cout << "FALHA: Codigo duplicado ou quarto ocupado no periodo.\n";
                 } catch (const exception& e) { cout << "ERRO: " << e.what() << endl; }
                 esperarEnter();
                 break;
@@ -267,7 +316,7 @@ void CntrMAReserva::menuReservas() {
             case 2: {
                 list<Reserva> lista = servicoReserva->listarReservas();
                 if(lista.empty()) cout << "Nenhuma reserva.\n";
-                for(const auto& r : lista) cout << "Reserva: " << r.getCodigo().getValor() << " | Valor: " << r.getValor().getValor() << endl;
+                for(const auto& r : lista) cout << "Reserva: " << r.getCodigo().getValor() << " | Quarto: " << r.getQuarto().getValor() << " | Valor: " << r.getValor().formatar() << endl;
                 esperarEnter();
                 break;
             }
@@ -277,7 +326,9 @@ void CntrMAReserva::menuReservas() {
                     Codigo c; c.setValor(codStr);
                     Reserva r = servicoReserva->lerReserva(c); // Pode lançar exceção se não achar
                     // Se a implementação do serviço retornar obj vazio em vez de throw, verificar aqui
-                    cout << "Encontrada! Chegada: " << r.getChegada().getDia() << "/" << r.getChegada().getMes() << endl;
+                    cout << "Encontrada! Quarto: " << r.getQuarto().getValor()
+                         << " | Chegada: " << r.getChegada().getDia() << "/" << r.getChegada().getMes()
+                         << " | Noites: " << r.getChegada().noitesAte(r.getPartida()) << endl;
                 } catch (const exception& e) { cout << "Nao encontrada ou erro: " << e.what() << endl; }
                 esperarEnter();
                 break;
@@ -302,13 +353,14 @@ void CntrMAReserva::menuReservas() {
 // --------------------------------------------------------------------
 void CntrMAReserva::menuHoteis() {
     int opcao = 0;
-    while (opcao != 5) {
+    while (opcao != 6) {
         cout << "\n--- MENU HOTEIS ---\n";
         cout << "1 - Cadastrar Hotel\n";
         cout << "2 - Listar Hoteis\n";
         cout << "3 - Pesquisar Hotel\n";
         cout << "4 - Deletar Hotel\n";
-        cout << "5 - Voltar\n";
+        cout << "5 - Buscar por Nome\n";
+        cout << "6 - Voltar\n";
         cout << "Selecione: ";
         cin >> opcao;
 
@@ -363,13 +415,26 @@ void CntrMAReserva::menuHoteis() {
                 string codStr; cout << "Codigo: "; cin >> codStr;
                 try {
                     Codigo c; c.setValor(codStr);
-                    if(servicoReserva->deletarHotel(c)) cout << "Hotel removido.\n";
-                    else cout << "Hotel nao encontrado.\n";
+                    if(servicoReserva->deletarHotel(c)) cout << "Hotel removido (com seus quartos e reservas).\n";
+                    else cout << "Hotel nao encontrado ou com dependentes.\n";
                 } catch (const exception& e) { cout << "ERRO: " << e.what() << endl; }
                 esperarEnter();
                 break;
             }
-            case 5: break;
+            case 5: { // BUSCAR POR NOME
+                string prefixo;
+                limparBuffer();
+                cout << "Inicio do nome: "; getline(cin, prefixo);
+                vector<Hotel> encontrados = servicoReserva->buscarHoteis(prefixo, 20);
+                if(encontrados.empty()) cout << "Nenhum hotel encontrado.\n";
+                for(const auto& h : encontrados) {
+                    cout << "COD: " << h.getCodigo().getValor()
+                         << " | NOME: " << h.getNome().getValor() << endl;
+                }
+                esperarEnter();
+                break;
+            }
+            case 6: break;
         }
     }
 }
@@ -396,18 +461,19 @@ void CntrMAReserva::menuQuartos() {
                 try {
                     Quarto q;
                     int num, cap, ram;
-                    string valStr;
-                    Numero n; Capacidade c; Dinheiro d; Ramal r;
+                    string valStr, hotStr;
+                    Numero n; Codigo h; Capacidade c; Dinheiro d; Ramal r;
 
                     cout << "Numero (1-999): "; cin >> num; n.setValor(num);
+                    cout << "Codigo do Hotel: "; cin >> hotStr; h.setValor(hotStr);
                     cout << "Capacidade (1-4): "; cin >> cap; c.setValor(cap);
-                    cout << "Diaria (00.00): "; cin >> valStr; d.setValor(stod(valStr));
+                    cout << "Diaria (00.00): "; cin >> valStr; d.setValor(valStr);
                     cout << "Ramal (0-50): "; cin >> ram; r.setValor(ram);
 
-                    q.setNumero(n); q.setCapacidade(c); q.setDiaria(d); q.setRamal(r);
+                    q.setNumero(n); q.setHotel(h); q.setCapacidade(c); q.setDiaria(d); q.setRamal(r);
 
                     if(servicoReserva->criarQuarto(q)) cout << "SUCESSO: Quarto criado.\n";
-                    else cout << "FALHA: Numero ja existe.\n";
+                    else cout << "FALHA: Numero ja existe ou hotel inexistente.\n";
 
                 } catch (const exception& e) { cout << "ERRO DADOS: " << e.what() << endl; }
                 esperarEnter();
@@ -418,8 +484,9 @@ void CntrMAReserva::menuQuartos() {
                 if(lista.empty()) cout << "Nenhum quarto cadastrado.\n";
                 for(const auto& q : lista) {
                     cout << "NUM: " << q.getNumero().getValor()
+                         << " | HOTEL: " << q.getHotel().getValor()
                          << " | CAP: " << q.getCapacidade().getValor()
-                         << " | R$: " << q.getDiaria().getValor() << endl;
+                         << " | R$: " << q.getDiaria().formatar() << endl;
                 }
                 esperarEnter();
                 break;
@@ -430,6 +497,7 @@ void CntrMAReserva::menuQuartos() {
                     Numero n; n.setValor(num);
                     Quarto q = servicoReserva->lerQuarto(n);
                     cout << "--- DETALHES QUARTO ---\n";
+                    cout << "Hotel: " << q.getHotel().getValor() << endl;
                     cout << "Capacidade: " << q.getCapacidade().getValor() << endl;
                     cout << "Ramal: " << q.getRamal().getValor() << endl;
                 } catch (const exception& e) { cout << "Nao encontrado: " << e.what() << endl; }
@@ -440,8 +508,8 @@ void CntrMAReserva::menuQuartos() {
                 int num; cout << "Numero: "; cin >> num;
                 try {
                     Numero n; n.setValor(num);
-                    if(servicoReserva->deletarQuarto(n)) cout << "Quarto removido.\n";
-                    else cout << "Quarto nao encontrado.\n";
+                    if(servicoReserva->deletarQuarto(n)) cout << "Quarto removido (com suas reservas).\n";
+                    else cout << "Quarto nao encontrado ou com reservas.\n";
                 } catch (const exception& e) { cout << "ERRO: " << e.what() << endl; }
                 esperarEnter();
                 break;
@@ -456,13 +524,14 @@ void CntrMAReserva::menuQuartos() {
 // --------------------------------------------------------------------
 void CntrMAReserva::menuHospedes() {
     int opcao = 0;
-    while (opcao != 5) {
+    while (opcao != 6) {
         cout << "\n--- MENU HOSPEDES ---\n";
         cout << "1 - Cadastrar Hospede\n";
         cout << "2 - Listar Hospedes\n";
         cout << "3 - Pesquisar Hospede\n";
         cout << "4 - Deletar Hospede\n";
-        cout << "5 - Voltar\n";
+        cout << "5 - Buscar por Nome\n";
+        cout << "6 - Voltar\n";
         cout << "Selecione: ";
         cin >> opcao;
 
@@ -522,11 +591,51 @@ void CntrMAReserva::menuHospedes() {
                 esperarEnter();
                 break;
             }
-            case 5: break;
+            case 5: { // BUSCAR POR NOME (até 2 erros de digitação)
+                string nomeStr;
+                limparBuffer();
+                cout << "Nome: "; getline(cin, nomeStr);
+                vector<Hospede> encontrados = servicoPessoa->buscarHospedes(nomeStr, 2, 20);
+                if(encontrados.empty()) cout << "Nenhum hospede encontrado.\n";
+                for(const auto& h : encontrados) {
+                    cout << "EMAIL: " << h.getEmail().getValor()
+                         << " | NOME: " << h.getNome().getValor() << endl;
+                }
+                esperarEnter();
+                break;
+            }
+            case 6: break;
         }
     }
 }
 
+// --------------------------------------------------------------------
+// IMPLEMENTAÇÃO: RELATÓRIO DE OCUPAÇÃO
+// --------------------------------------------------------------------
+void CntrMAReserva::menuRelatorio() {
+    try {
+        string dI, mI, aI, dF, mF, aF;
+        Data ini; Data fim;
+
+        cout << "\n--- RELATORIO DE OCUPACAO ---\n";
+        cout << "Inicio (DD MMM AAAA): "; cin >> dI >> mI >> aI; ini.setValor(stoi(dI), mI, stoi(aI));
+        cout << "Fim (DD MMM AAAA): "; cin >> dF >> mF >> aF; fim.setValor(stoi(dF), mF, stoi(aF));
+
+        RelatorioOcupacao relatorio = servicoReserva->gerarRelatorio(ini, fim);
+        auto imprimir = [](const string& rotulo, const IndicadoresHotel& i) {
+            cout << rotulo
+                 << " | Ocupacao: " << fixed << setprecision(1) << i.ocupacao() * 100 << "%"
+                 << " | Receita R$: " << formatarCentavos(i.receita)
+                 << " | ADR R$: " << formatarCentavos(i.diariaMedia()) << endl;
+        };
+
+        if (relatorio.hoteis.empty()) cout << "Nenhum hotel cadastrado.\n";
+        for (const auto& indicadores : relatorio.hoteis) imprimir("Hotel " + indicadores.hotel.getValor(), indicadores);
+        imprimir("TOTAL", relatorio.consolidado);
+    } catch (const exception& e) { cout << "ERRO: " << e.what() << endl; }
+    esperarEnter();
+}
+
 // ====================================================================
 // 4. IMPLEMENTAÇÃO: CONTROLADORA DE INTEGRAÇÃO (MAI)
 // ====================================================================
@@ -560,12 +669,21 @@ void CntrMAIntegracao::executar() {
             }
         }
         else if (opcao == 1) {
-            // Chama o módulo de autenticação para LOGAR
-            if (cntrAutenticacao->autenticar(emailUsuarioLogado)) {
+            // Chama o módulo de autenticação para LOGAR (com sessão, se configurada)
+            bool logou = servicoSessao ? cntrAutenticacao->autenticar(emailUsuarioLogado, tokenSessao)
+                                       : cntrAutenticacao->autenticar(emailUsuarioLogado);
+            if (logou) {
                 autenticado = true;
 
                 // LOOP DO USUÁRIO LOGADO
                 while (autenticado) {
+                    // A sessão pode ter expirado ou sido revogada (ex.: gerente excluído)
+                    if (servicoSessao && !servicoSessao->validarSessao(tokenSessao, &emailUsuarioLogado)) {
+                        cout << "Sessao expirada. Faca login novamente.\n";
+                        autenticado = false;
+                        break;
+                    }
+
                     cout << "\n=== MENU PRINCIPAL (Logado: " << emailUsuarioLogado.getValor() << ") ===\n";
                     cout << "1 - Meu Perfil\n";
                     cout << "2 - Gestao de Hotel e Reservas\n";
@@ -579,7 +697,9 @@ void CntrMAIntegracao::executar() {
                     switch(opLogado) {
                         case 1: cntrPessoal->executar(emailUsuarioLogado); break;
                         case 2: cntrReserva->executar(emailUsuarioLogado); break;
-                        case 0: autenticado = false; cout << "Deslogado.\n"; break;
+                        case 0:
+                            if (servicoSessao) servicoSessao->encerrarSessao(tokenSessao);
+                            autenticado = false; cout << "Deslogado.\n"; break;
                         default: cout << "Opcao invalida.\n";
                     }
                 }
@@ -1,10 +1,15 @@
 #include "services.hpp"
 #include "containers.hpp"
+#include "transacoes.hpp"
 #include <iostream>
 #include <list>
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <tuple>
 
 using namespace std;
 
@@ -12,44 +17,12 @@ using namespace std;
 // UTILITÁRIOS DE DATA (Para verificar conflitos)
 // ====================================================================
 
-// Converte mês string para int (ex: "JAN" -> 1)
-int mesParaInt(string mes) {
-    // Transforma para maiúsculo para garantir
-    for (auto &c : mes) c = toupper(c);
-    if (mes == "JAN") return 1;
-    if (mes == "FEV") return 2;
-    if (mes == "MAR") return 3;
-    if (mes == "ABR") return 4;
-    if (mes == "MAI") return 5;
-    if (mes == "JUN") return 6;
-    if (mes == "JUL") return 7;
-    if (mes == "AGO") return 8;
-    if (mes == "SET") return 9;
-    if (mes == "OUT") return 10;
-    if (mes == "NOV") return 11;
-    if (mes == "DEZ") return 12;
-    return 0;
-}
-
-// Converte Data para um inteiro comparável YYYYMMDD
-long dataParaLong(const Data& d) {
-    long ano = d.getAno();
-    long mes = mesParaInt(d.getMes());
-    long dia = d.getDia();
-    return (ano * 10000) + (mes * 100) + dia;
-}
-
-// Verifica se dois intervalos de data se sobrepõem
-// [Ini1, Fim1] vs [Ini2, Fim2]
+// Verifica se duas estadias disputam alguma noite
+// [Ini1, Fim1) vs [Ini2, Fim2): o dia de partida fica livre para nova chegada
 bool verificarSobreposicao(const Data& inicio1, const Data& fim1,
                            const Data& inicio2, const Data& fim2) {
-    long i1 = dataParaLong(inicio1);
-    long f1 = dataParaLong(fim1);
-    long i2 = dataParaLong(inicio2);
-    long f2 = dataParaLong(fim2);
-
-    // Lógica clássica de colisão: InicioA <= FimB E FimA >= InicioB
-    return (i1 <= f2 && f1 >= i2);
+    // Lógica clássica de colisão: InicioA < FimB E InicioB < FimA
+    return (inicio1 < fim2 && inicio2 < fim1);
 }
 
 // ====================================================================
@@ -57,21 +30,325 @@ bool verificarSobreposicao(const Data& inicio1, const Data& fim1,
 // ====================================================================
 
 bool CntrMSAutenticacao::autenticar(const EMAIL& email, const Senha& senha) {
-    Gerente gerente;
-    gerente.setEmail(email);
+    return autenticar(email, senha, "");
+}
+
+bool CntrMSAutenticacao::autenticar(const EMAIL& email, const Senha& senha, const string& origem) {
+    auto promessa = make_shared<promise<bool>>();
+    future<bool> resultado = promessa->get_future();
+    autenticarAssincrono(email, senha, origem, [promessa](bool autenticado, exception_ptr falha) {
+        if (falha) promessa->set_exception(falha);
+        else promessa->set_value(autenticado);
+    });
+    return resultado.get();
+}
+
+void CntrMSAutenticacao::autenticarAssincrono(const EMAIL& email, const Senha& senha, const string& origem,
+                                              function<void(bool, exception_ptr)> aoConcluir) {
+    // Consulta barata antes do hash: tentativas bloqueadas não chegam ao verificador
+    if (!limitador.permitido(email, origem))
+        throw runtime_error("Muitas tentativas de login. Tente novamente mais tarde.");
+
+    // Email desconhecido é conferido contra uma credencial fictícia, com o mesmo custo:
+    // o tempo de resposta não revela quais emails estão cadastrados
+    static const Credencial FICTICIA = DerivadorSenha::gerar("");
+
+    Credencial credencial;
+    bool existe = container->obterCredencial(email, &credencial);
+    VerificadorSenhas::instancia().submeter(
+        [this, existe, credencial = existe ? credencial : FICTICIA, senha = senha.getValor(), email, origem,
+         aoConcluir = std::move(aoConcluir)] {
+        // Uma falha aqui (ex.: bad_alloc no buffer da derivação) segue para quem espera o resultado
+        bool autenticado = false;
+        exception_ptr falha;
+        try {
+            autenticado = DerivadorSenha::conferir(credencial, senha) && existe;
+            if (!autenticado) limitador.registrarFalha(email, origem);
+        } catch (...) {
+            falha = current_exception();
+        }
+        aoConcluir(autenticado, falha);
+    });
+}
+
+// --- LIMITADOR DE TENTATIVAS ---
+
+LimitadorTentativas::LimitadorTentativas(uint32_t limiteEmail, uint32_t limiteOrigem, chrono::seconds janela)
+    : limiteEmail(limiteEmail), limiteOrigem(limiteOrigem), duracaoJanela(janela.count()) {
+    if (duracaoJanela <= 0) throw invalid_argument("Janela de tentativas deve ser positiva.");
+    for (auto& posicao : porEmail.posicoes) posicao.store(0, memory_order_relaxed);
+    for (auto& posicao : porOrigem.posicoes) posicao.store(0, memory_order_relaxed);
+}
+
+uint32_t LimitadorTentativas::janelaAtual() const {
+    long long segundos = chrono::duration_cast<chrono::seconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+    // Janelas 0 e 1 ficam para células nunca usadas
+    return static_cast<uint32_t>((segundos / duracaoJanela + 2) & 0xFFFFFF);
+}
+
+uint64_t LimitadorTentativas::misturar(uint64_t chave) {
+    // Finalizador do splitmix64: espalha bem os bits antes de escolher as posições
+    chave += 0x9e3779b97f4a7c15ULL;
+    chave = (chave ^ (chave >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    chave = (chave ^ (chave >> 27)) * 0x94d049bb133111ebULL;
+    return chave ^ (chave >> 31);
+}
+
+namespace {
+
+// Célula: [janela: 24 bits | impressão: 24 bits | contagem: 16 bits]
+inline uint32_t janelaDaCelula(uint64_t celula) { return static_cast<uint32_t>(celula >> 40); }
+inline uint32_t impressaoDaCelula(uint64_t celula) { return static_cast<uint32_t>(celula >> 16) & 0xFFFFFF; }
+inline uint64_t montarCelula(uint32_t janela, uint32_t impressao, uint32_t contagem) {
+    return (uint64_t(janela) << 40) | (uint64_t(impressao) << 16) | contagem;
+}
+
+} // namespace
+
+uint32_t LimitadorTentativas::contagemEfetiva(uint64_t celula, uint32_t janela) {
+    uint32_t contagem = static_cast<uint32_t>(celula & 0xFFFF);
+    if (janelaDaCelula(celula) == janela) return contagem;
+    if (((janelaDaCelula(celula) + 1) & 0xFFFFFF) == janela) return contagem / 2; // Decaimento da janela anterior
+    return 0;
+}
+
+uint32_t LimitadorTentativas::consultar(const Tabela& tabela, uint64_t chave, uint32_t janela) {
+    uint64_t espalhada = misturar(chave);
+    uint32_t impressao = static_cast<uint32_t>(misturar(espalhada) >> 40);
+    uint32_t contagem = 0;
+    for (size_t posicao : {size_t(espalhada % POSICOES), size_t((espalhada >> 32) % POSICOES)}) {
+        uint64_t celula = tabela.posicoes[posicao].load(memory_order_relaxed);
+        if (impressaoDaCelula(celula) == impressao) contagem = max(contagem, contagemEfetiva(celula, janela));
+    }
+    return contagem;
+}
+
+void LimitadorTentativas::registrar(Tabela& tabela, uint64_t chave, uint32_t janela) {
+    uint64_t espalhada = misturar(chave);
+    uint32_t impressao = static_cast<uint32_t>(misturar(espalhada) >> 40);
+    atomic<uint64_t>& a = tabela.posicoes[espalhada % POSICOES];
+    atomic<uint64_t>& b = tabela.posicoes[(espalhada >> 32) % POSICOES];
+
+    while (true) {
+        uint64_t celulaA = a.load(memory_order_relaxed);
+        uint64_t celulaB = b.load(memory_order_relaxed);
+        uint32_t contagemA = contagemEfetiva(celulaA, janela);
+        uint32_t contagemB = contagemEfetiva(celulaB, janela);
+
+        // Continua a contagem da própria chave; senão, ocupa a candidata mais fraca
+        atomic<uint64_t>* alvo;
+        uint64_t esperado;
+        uint32_t contagem;
+        if (impressaoDaCelula(celulaA) == impressao && contagemA > 0) {
+            alvo = &a; esperado = celulaA; contagem = contagemA;
+        } else if (impressaoDaCelula(celulaB) == impressao && contagemB > 0) {
+            alvo = &b; esperado = celulaB; contagem = contagemB;
+        } else if (contagemA <= contagemB) {
+            alvo = &a; esperado = celulaA; contagem = 0;
+        } else {
+            alvo = &b; esperado = celulaB; contagem = 0;
+        }
+        if (contagem < 0xFFFF) contagem++;
+
+        if (alvo->compare_exchange_weak(esperado, montarCelula(janela, impressao, contagem),
+                                        memory_order_relaxed)) return;
+    }
+}
+
+bool LimitadorTentativas::permitido(const EMAIL& email, const string& origem) const {
+    uint32_t janela = janelaAtual();
+    if (consultar(porEmail, hash<EMAIL>()(email), janela) >= limiteEmail) return false;
+    if (!origem.empty() && consultar(porOrigem, hash<string>()(origem), janela) >= limiteOrigem) return false;
+    return true;
+}
+
+void LimitadorTentativas::registrarFalha(const EMAIL& email, const string& origem) {
+    uint32_t janela = janelaAtual();
+    registrar(porEmail, hash<EMAIL>()(email), janela);
+    if (!origem.empty()) registrar(porOrigem, hash<string>()(origem), janela);
+}
+
+// --- SESSÕES ---
+
+CntrMSSessao::CntrMSSessao()
+    : servicoAutenticacao(nullptr),
+      limiteOcioso(chrono::duration_cast<chrono::nanoseconds>(chrono::minutes(30)).count()),
+      limiteAbsoluto(chrono::duration_cast<chrono::nanoseconds>(chrono::hours(12)).count()) {
+    for (auto& fragmento : fragmentos) fragmento.sessoes.reserve(SESSOES_PREVISTAS / FRAGMENTOS);
+}
+
+long long CntrMSSessao::agora() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+string CntrMSSessao::gerarToken() {
+    // random_device lê a fonte de entropia do sistema: tokens não são previsíveis
+    thread_local random_device fonte;
+    static constexpr char HEX[] = "0123456789abcdef";
+
+    string token(32, '0');
+    for (size_t i = 0; i < token.size(); i += 8) {
+        uint32_t bits = fonte();
+        for (size_t j = 0; j < 8; j++, bits >>= 4) token[i + j] = HEX[bits & 0xF];
+    }
+    return token;
+}
+
+CntrMSSessao::Fragmento& CntrMSSessao::fragmentoDe(const string& token) {
+    return fragmentos[hash<string>()(token) % FRAGMENTOS];
+}
+
+bool CntrMSSessao::expirada(const Sessao& sessao, long long instante) const {
+    return instante - sessao.criacao >= limiteAbsoluto.load(memory_order_relaxed)
+        || instante - sessao.ultimoAcesso.load(memory_order_relaxed) >= limiteOcioso.load(memory_order_relaxed);
+}
+
+void CntrMSSessao::removerDoIndice(const EMAIL& email, const string& token) {
+    auto it = tokensPorGerente.find(email);
+    if (it == tokensPorGerente.end()) return;
+    vector<string>& tokens = it->second;
+    for (size_t i = 0; i < tokens.size(); i++) {
+        if (tokens[i] != token) continue;
+        tokens[i] = std::move(tokens.back());
+        tokens.pop_back();
+        break;
+    }
+    if (tokens.empty()) tokensPorGerente.erase(it);
+}
+
+void CntrMSSessao::varrerFragmento(Fragmento& fragmento) {
+    long long instante = agora();
+    lock_guard<mutex> donos(travaDonos);
+    unique_lock<shared_mutex> escrita(fragmento.trava);
+    for (auto it = fragmento.sessoes.begin(); it != fragmento.sessoes.end(); ) {
+        if (expirada(it->second, instante)) {
+            removerDoIndice(it->second.email, it->first);
+            it = fragmento.sessoes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+string CntrMSSessao::abrirSessao(const EMAIL& email, const Senha& senha, const string& origem) {
+    return abrirSessaoAssincrona(email, senha, origem).get();
+}
+
+future<string> CntrMSSessao::abrirSessaoAssincrona(const EMAIL& email, const Senha& senha, const string& origem) {
+    auto promessa = make_shared<promise<string>>();
+    future<string> resultado = promessa->get_future();
+    tentarAbrir(email, senha, origem, promessa);
+    return resultado;
+}
+
+void CntrMSSessao::tentarAbrir(const EMAIL& email, const Senha& senha, const string& origem,
+                               shared_ptr<promise<string>> promessa) {
+    uint64_t epoca = revogacoes.load(memory_order_acquire);
+    servicoAutenticacao->autenticarAssincrono(email, senha, origem,
+        [this, email, senha, origem, promessa, epoca](bool autenticado, exception_ptr falha) {
+        if (falha) {
+            promessa->set_exception(falha);
+            return;
+        }
+        if (!autenticado) {
+            promessa->set_value("");
+            return;
+        }
+        // Roda na thread de verificação: o que falhar aqui (gerarToken, nova tentativa) vai para o futuro
+        try {
+            string token = gerarToken();
+            Fragmento& fragmento = fragmentoDe(token);
+            {
+                // Uma revogação durante a autenticação pode ter excluído o gerente
+                lock_guard<mutex> donos(travaDonos);
+                if (revogacoes.load(memory_order_relaxed) == epoca) {
+                    unique_lock<shared_mutex> escrita(fragmento.trava);
+                    fragmento.sessoes.emplace(piecewise_construct, forward_as_tuple(token),
+                                              forward_as_tuple(email, agora()));
+                    tokensPorGerente[email].push_back(token);
+                } else {
+                    token.clear();
+                }
+            }
+            if (token.empty()) {
+                tentarAbrir(email, senha, origem, promessa);
+                return;
+            }
 
-    // Busca no container
-    if (container->pesquisar(&gerente)) {
-        // Se encontrou, compara a senha
-        if (gerente.getSenha().getValor() == senha.getValor()) {
+            // Coleta periódica de sessões abandonadas, um fragmento por vez
+            size_t abertura = aberturas.fetch_add(1, memory_order_relaxed) + 1;
+            if (abertura % ABERTURAS_POR_VARREDURA == 0) {
+                varrerFragmento(fragmentos[(abertura / ABERTURAS_POR_VARREDURA) % FRAGMENTOS]);
+            }
+            promessa->set_value(token);
+        } catch (...) {
+            promessa->set_exception(current_exception());
+        }
+    });
+}
+
+bool CntrMSSessao::validarSessao(const string& token, EMAIL* email) {
+    Fragmento& fragmento = fragmentoDe(token);
+    long long instante = agora();
+    {
+        shared_lock<shared_mutex> leitura(fragmento.trava);
+        auto it = fragmento.sessoes.find(token);
+        if (it == fragmento.sessoes.end()) return false;
+        if (!expirada(it->second, instante)) {
+            it->second.ultimoAcesso.store(instante, memory_order_relaxed);
+            if (email) *email = it->second.email;
             return true;
         }
     }
-    // Para fins de teste fumaça, podemos hardcode um admin se o container estiver vazio?
-    // Não, vamos assumir que o sistema popula ou cria no início.
+    encerrarSessao(token); // Expirada: sai da tabela e do índice
     return false;
 }
 
+bool CntrMSSessao::encerrarSessao(const string& token) {
+    Fragmento& fragmento = fragmentoDe(token);
+    lock_guard<mutex> donos(travaDonos);
+    unique_lock<shared_mutex> escrita(fragmento.trava);
+    auto it = fragmento.sessoes.find(token);
+    if (it == fragmento.sessoes.end()) return false;
+    removerDoIndice(it->second.email, token);
+    fragmento.sessoes.erase(it);
+    return true;
+}
+
+size_t CntrMSSessao::revogarSessoes(const EMAIL& email) {
+    lock_guard<mutex> donos(travaDonos);
+    revogacoes.fetch_add(1, memory_order_release); // Mesmo sem sessões: há aberturas em andamento
+    auto it = tokensPorGerente.find(email);
+    if (it == tokensPorGerente.end()) return 0;
+
+    size_t revogadas = 0;
+    for (const auto& token : it->second) {
+        Fragmento& fragmento = fragmentoDe(token);
+        unique_lock<shared_mutex> escrita(fragmento.trava);
+        revogadas += fragmento.sessoes.erase(token);
+    }
+    tokensPorGerente.erase(it);
+    return revogadas;
+}
+
+void CntrMSSessao::setLimites(chrono::seconds ocioso, chrono::seconds absoluto) {
+    if (ocioso.count() <= 0 || absoluto.count() <= 0)
+        throw invalid_argument("Prazos de sessao devem ser positivos.");
+    limiteOcioso.store(chrono::duration_cast<chrono::nanoseconds>(ocioso).count(), memory_order_relaxed);
+    limiteAbsoluto.store(chrono::duration_cast<chrono::nanoseconds>(absoluto).count(), memory_order_relaxed);
+}
+
+size_t CntrMSSessao::contarSessoes() {
+    size_t total = 0;
+    for (auto& fragmento : fragmentos) {
+        shared_lock<shared_mutex> leitura(fragmento.trava);
+        total += fragmento.sessoes.size();
+    }
+    return total;
+}
+
 // ====================================================================
 // 2. SERVIÇO DE PESSOAL (MSP)
 // ====================================================================
@@ -87,7 +364,9 @@ bool CntrMSPessoa::criarGerente(const Gerente& gerente) {
 }
 
 bool CntrMSPessoa::deletarGerente(const EMAIL& email) {
-    return containerGerentes->remover(email);
+    if (!containerGerentes->remover(email)) return false;
+    if (servicoSessao) servicoSessao->revogarSessoes(email);
+    return true;
 }
 
 bool CntrMSPessoa::atualizarGerente(const Gerente& gerente) {
@@ -124,6 +403,10 @@ bool CntrMSPessoa::atualizarHospede(const Hospede& hospede) {
     return containerHospedes->atualizar(hospede);
 }
 
+ResultadoAtualizacao CntrMSPessoa::atualizarHospede(const Hospede& hospede, unsigned long long versaoEsperada) {
+    return containerHospedes->atualizar(hospede, versaoEsperada);
+}
+
 Hospede CntrMSPessoa::lerHospede(const EMAIL& email) {
     Hospede h;
     h.setEmail(email);
@@ -137,31 +420,203 @@ list<Hospede> CntrMSPessoa::listarHospedes() {
     return containerHospedes->listar();
 }
 
+vector<Hospede> CntrMSPessoa::buscarHospedes(const string& nome, unsigned distanciaMaxima, size_t limite) {
+    return containerHospedes->buscarPorNome(nome, distanciaMaxima, limite);
+}
+
 // ====================================================================
 // 3. SERVIÇO DE RESERVAS E INFRA (MSR)
 // ====================================================================
 
+// --- IDEMPOTÊNCIA ---
+
+RegistroIdempotencia::RegistroIdempotencia(size_t capacidade, chrono::seconds validade)
+    : capacidadeFragmento(max<size_t>(1, capacidade / FRAGMENTOS)),
+      validade(chrono::duration_cast<chrono::nanoseconds>(validade).count()) {
+    if (validade.count() <= 0) throw invalid_argument("Validade deve ser positiva.");
+}
+
+long long RegistroIdempotencia::agora() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+RegistroIdempotencia::Fragmento& RegistroIdempotencia::fragmentoDe(const string& chave) {
+    return fragmentos[hash<string>()(chave) % FRAGMENTOS];
+}
+
+void RegistroIdempotencia::descartarAntigas(Fragmento& fragmento, long long instante, size_t limite) {
+    while (!fragmento.chegada.empty() &&
+           (fragmento.chegada.front().second <= instante || fragmento.entradas.size() >= limite)) {
+        // A entrada pode já ter saído (exceção) ou sido registrada de novo depois de expirar
+        auto it = fragmento.entradas.find(fragmento.chegada.front().first);
+        if (it != fragmento.entradas.end() && it->second.expiracao == fragmento.chegada.front().second) {
+            fragmento.entradas.erase(it);
+        }
+        fragmento.chegada.pop_front();
+    }
+}
+
+bool RegistroIdempotencia::executar(const string& chave, const function<bool()>& operacao) {
+    Fragmento& fragmento = fragmentoDe(chave);
+    const long long instante = agora();
+    promise<bool> promessa;
+    const long long expiracao = instante + validade;
+
+    unique_lock<mutex> bloqueio(fragmento.trava);
+    auto it = fragmento.entradas.find(chave);
+    if (it != fragmento.entradas.end() && it->second.expiracao > instante) {
+        shared_future<bool> resultado = it->second.resultado;
+        bloqueio.unlock();
+        return resultado.get(); // Espera, se a primeira execução ainda estiver em curso
+    }
+    if (it != fragmento.entradas.end()) fragmento.entradas.erase(it);
+
+    descartarAntigas(fragmento, instante, capacidadeFragmento);
+    fragmento.entradas[chave] = {promessa.get_future().share(), expiracao};
+    fragmento.chegada.emplace_back(chave, expiracao);
+    bloqueio.unlock();
+
+    bool resultado;
+    try {
+        resultado = operacao();
+    } catch (...) {
+        bloqueio.lock();
+        it = fragmento.entradas.find(chave);
+        if (it != fragmento.entradas.end() && it->second.expiracao == expiracao) fragmento.entradas.erase(it);
+        bloqueio.unlock();
+        promessa.set_exception(current_exception()); // Quem esperava recebe a mesma exceção
+        throw;
+    }
+    promessa.set_value(resultado);
+    return resultado;
+}
+
+size_t RegistroIdempotencia::tamanho() {
+    size_t total = 0;
+    for (auto& fragmento : fragmentos) {
+        lock_guard<mutex> bloqueio(fragmento.trava);
+        total += fragmento.entradas.size();
+    }
+    return total;
+}
+
+// --- LISTA DE ESPERA ---
+
+bool ListaEspera::incluir(const Reserva& reserva, unsigned prioridade) {
+    if (porCodigo.count(reserva.getCodigo())) return false;
+    EsperaQuarto& espera = porQuarto[reserva.getQuarto()];
+    auto it = espera.porChegada.emplace(reserva.getChegada().getSerial(),
+                                        Pedido{reserva, prioridade, proximaOrdem++});
+    espera.maiorEstadia = max(espera.maiorEstadia, reserva.getChegada().noitesAte(reserva.getPartida()));
+    porCodigo.emplace(reserva.getCodigo(), it);
+    return true;
+}
+
+bool ListaEspera::remover(const Codigo& codigo) {
+    auto it = porCodigo.find(codigo);
+    if (it == porCodigo.end()) return false;
+    auto espera = porQuarto.find(it->second->second.reserva.getQuarto());
+    espera->second.porChegada.erase(it->second);
+    if (espera->second.porChegada.empty()) porQuarto.erase(espera);
+    porCodigo.erase(it);
+    return true;
+}
+
+void ListaEspera::removerQuarto(const Numero& quarto) {
+    auto espera = porQuarto.find(quarto);
+    if (espera == porQuarto.end()) return;
+    for (const auto& item : espera->second.porChegada) porCodigo.erase(item.second.reserva.getCodigo());
+    porQuarto.erase(espera);
+}
+
+vector<Reserva> ListaEspera::ordenar(vector<const Pedido*>& pedidos) {
+    sort(pedidos.begin(), pedidos.end(), [](const Pedido* a, const Pedido* b) {
+        return a->prioridade != b->prioridade ? a->prioridade > b->prioridade : a->ordem < b->ordem;
+    });
+    vector<Reserva> reservas;
+    reservas.reserve(pedidos.size());
+    for (const Pedido* pedido : pedidos) reservas.push_back(pedido->reserva);
+    return reservas;
+}
+
+vector<Reserva> ListaEspera::candidatas(const Numero& quarto, const Data& inicio, const Data& fim) const {
+    vector<const Pedido*> pedidos;
+    auto espera = porQuarto.find(quarto);
+    if (espera != porQuarto.end()) {
+        // Chegadas anteriores a inicio - maiorEstadia não alcançam o intervalo
+        const Pedidos& porChegada = espera->second.porChegada;
+        auto it = porChegada.lower_bound(inicio.getSerial() - espera->second.maiorEstadia);
+        auto limite = porChegada.lower_bound(fim.getSerial());
+        for (; it != limite; ++it) {
+            if (it->second.reserva.getPartida() > inicio) pedidos.push_back(&it->second);
+        }
+    }
+    return ordenar(pedidos);
+}
+
+vector<Reserva> ListaEspera::listar(const Numero& quarto) const {
+    vector<const Pedido*> pedidos;
+    auto espera = porQuarto.find(quarto);
+    if (espera != porQuarto.end()) {
+        for (const auto& item : espera->second.porChegada) pedidos.push_back(&item.second);
+    }
+    return ordenar(pedidos);
+}
+
 // --- HOTEL ---
 
 bool CntrMSReserva::criarHotel(const Hotel& hotel) {
+    unique_lock<shared_mutex> bloqueio(trava);
     Hotel hTemp;
     hTemp.setCodigo(hotel.getCodigo());
     if (containerHoteis->pesquisar(&hTemp)) return false;
-    return containerHoteis->incluir(hotel);
+    if (!containerHoteis->incluir(hotel)) return false;
+    baseDesatualizada = true;
+    return true;
 }
 
 bool CntrMSReserva::deletarHotel(const Codigo& codigo) {
-    return containerHoteis->remover(codigo);
+    unique_lock<shared_mutex> bloqueio(trava);
+    vector<Numero> quartos = containerQuartos->listarPorHotel(codigo);
+    if (politicaExclusao == PoliticaExclusao::RESTRINGIR && !quartos.empty()) return false;
+
+    if (!containerHoteis->remover(codigo)) return false;
+    for (const auto& numero : quartos) {
+        containerReservas->removerPorQuarto(numero);
+        containerQuartos->remover(numero);
+    }
+    {
+        lock_guard<mutex> bloqueioEspera(travaEspera);
+        for (const auto& numero : quartos) listaEspera.removerQuarto(numero);
+    }
+    cacheHoteis.invalidar(codigo);
+    for (const auto& numero : quartos) cacheQuartos.invalidar(numero);
+    baseDesatualizada = true;
+    return true;
 }
 
 bool CntrMSReserva::atualizarHotel(const Hotel& hotel) {
-    return containerHoteis->atualizar(hotel);
+    unique_lock<shared_mutex> bloqueio(trava);
+    if (!containerHoteis->atualizar(hotel)) return false;
+    cacheHoteis.invalidar(hotel.getCodigo());
+    baseDesatualizada = true;
+    return true;
 }
 
 Hotel CntrMSReserva::lerHotel(const Codigo& codigo) {
-    Hotel h;
-    h.setCodigo(codigo);
-    if(!containerHoteis->pesquisar(&h)) throw runtime_error("Hotel nao encontrado.");
+    return *obterHotel(codigo);
+}
+
+shared_ptr<const Hotel> CntrMSReserva::obterHotel(const Codigo& codigo) {
+    if (shared_ptr<const Hotel> guardado = cacheHoteis.buscar(codigo)) return guardado;
+
+    // Sem invalidações entre a leitura do container e o registro na cache
+    shared_lock<shared_mutex> bloqueio = travarLeitura();
+    auto h = make_shared<Hotel>();
+    h->setCodigo(codigo);
+    if(!containerHoteis->pesquisar(h.get())) throw runtime_error("Hotel nao encontrado.");
+    cacheHoteis.guardar(codigo, h);
     return h;
 }
 
@@ -169,27 +624,71 @@ list<Hotel> CntrMSReserva::listarHoteis() {
     return containerHoteis->listar();
 }
 
+vector<Hotel> CntrMSReserva::buscarHoteis(const string& prefixo, size_t limite) {
+    return containerHoteis->buscarPorPrefixo(prefixo, limite);
+}
+
 // --- QUARTO ---
 
 bool CntrMSReserva::criarQuarto(const Quarto& quarto) {
+    unique_lock<shared_mutex> bloqueio(trava);
     Quarto qTemp;
     qTemp.setNumero(quarto.getNumero());
     if (containerQuartos->pesquisar(&qTemp)) return false;
-    return containerQuartos->incluir(quarto);
+
+    // O quarto deve pertencer a um hotel cadastrado
+    Hotel hTemp;
+    hTemp.setCodigo(quarto.getHotel());
+    if (!containerHoteis->pesquisar(&hTemp)) return false;
+
+    if (!containerQuartos->incluir(quarto)) return false;
+    baseDesatualizada = true;
+    return true;
 }
 
 bool CntrMSReserva::deletarQuarto(const Numero& numero) {
-    return containerQuartos->remover(numero);
+    unique_lock<shared_mutex> bloqueio(trava);
+    if (politicaExclusao == PoliticaExclusao::RESTRINGIR) {
+        bool temReservas = false;
+        containerReservas->percorrerPorQuarto(numero, [&](const Reserva&) { temReservas = true; });
+        if (temReservas) return false;
+    }
+
+    if (!containerQuartos->remover(numero)) return false;
+    containerReservas->removerPorQuarto(numero);
+    {
+        lock_guard<mutex> bloqueioEspera(travaEspera);
+        listaEspera.removerQuarto(numero);
+    }
+    cacheQuartos.invalidar(numero);
+    baseDesatualizada = true;
+    return true;
 }
 
 bool CntrMSReserva::atualizarQuarto(const Quarto& quarto) {
-    return containerQuartos->atualizar(quarto);
+    unique_lock<shared_mutex> bloqueio(trava);
+    Hotel hTemp;
+    hTemp.setCodigo(quarto.getHotel());
+    if (!containerHoteis->pesquisar(&hTemp)) return false;
+
+    if (!containerQuartos->atualizar(quarto)) return false;
+    cacheQuartos.invalidar(quarto.getNumero());
+    baseDesatualizada = true;
+    return true;
 }
 
 Quarto CntrMSReserva::lerQuarto(const Numero& numero) {
-    Quarto q;
-    q.setNumero(numero);
-    if(!containerQuartos->pesquisar(&q)) throw runtime_error("Quarto nao encontrado.");
+    return *obterQuarto(numero);
+}
+
+shared_ptr<const Quarto> CntrMSReserva::obterQuarto(const Numero& numero) {
+    if (shared_ptr<const Quarto> guardado = cacheQuartos.buscar(numero)) return guardado;
+
+    shared_lock<shared_mutex> bloqueio = travarLeitura();
+    auto q = make_shared<Quarto>();
+    q->setNumero(numero);
+    if(!containerQuartos->pesquisar(q.get())) throw runtime_error("Quarto nao encontrado.");
+    cacheQuartos.guardar(numero, q);
     return q;
 }
 
@@ -199,42 +698,141 @@ list<Quarto> CntrMSReserva::listarQuartos() {
 
 // --- RESERVA ---
 
-bool CntrMSReserva::criarReserva(const Reserva& reserva) {
-    // 1. Verifica duplicidade de código (PK)
+// Chamada com a trava do serviço e a faixa do quarto (ou a trava exclusiva).
+// EM_ESPERA indica conflito de datas; quem decide se o pedido espera é o chamador.
+SituacaoSolicitacao CntrMSReserva::incluirReserva(const Reserva& reserva) {
+    // 1. Verifica duplicidade de código (PK); a inclusão repete a verificação sob
+    //    a trava do container, pois outra faixa pode incluir o mesmo código
     Reserva rTemp;
     rTemp.setCodigo(reserva.getCodigo());
-    if (containerReservas->pesquisar(&rTemp)) return false;
+    if (containerReservas->pesquisar(&rTemp)) return SituacaoSolicitacao::RECUSADA;
 
-    // 2. Verifica conflito de datas (Regra de Negócio)
-    list<Reserva> existentes = containerReservas->listar();
-    for (const auto& rExistente : existentes) {
-        // Nota: Em um sistema real, verificaríamos também se é o mesmo Quarto.
-        // Como o PDF simplifica e associa reserva a hotel/quarto genericamente ou
-        // não especifica chave estrangeira na classe Reserva (apenas no diagrama ER se houvesse),
-        // assumiremos conflito global ou que o teste é simplificado.
+    // 2. A estadia deve ter ao menos uma noite, em um quarto existente
+    if (reserva.getPartida() <= reserva.getChegada()) return SituacaoSolicitacao::RECUSADA;
+    Quarto qTemp;
+    qTemp.setNumero(reserva.getQuarto());
+    if (!containerQuartos->pesquisar(&qTemp)) return SituacaoSolicitacao::RECUSADA;
 
-        bool conflito = verificarSobreposicao(
+    // 3. Verifica conflito de datas no mesmo quarto (Regra de Negócio),
+    //    percorrendo só as reservas do quarto pelo índice reverso
+    bool conflito = false;
+    containerReservas->percorrerPorQuarto(reserva.getQuarto(), [&](const Reserva& rExistente) {
+        conflito = conflito || verificarSobreposicao(
             reserva.getChegada(), reserva.getPartida(),
             rExistente.getChegada(), rExistente.getPartida()
         );
+    });
+    if (conflito) return SituacaoSolicitacao::EM_ESPERA;
 
-        if (conflito) {
-            // Conflito detectado!
-            return false;
-        }
-    }
+    // 4. O valor gravado é sempre o do motor tarifário, não o informado
+    Reserva precificada = reserva;
+    if (!precificar(precificada, qTemp.getDiaria())) return SituacaoSolicitacao::RECUSADA;
+    if (!containerReservas->incluir(precificada)) return SituacaoSolicitacao::RECUSADA;
+    baseDesatualizada = true;
+    return SituacaoSolicitacao::CRIADA;
+}
 
-    return containerReservas->incluir(reserva);
+// Chamada com a trava do serviço (regras tarifárias estáveis) e período já validado.
+// false se o total exceder o limite de Dinheiro.
+bool CntrMSReserva::precificar(Reserva& reserva, const Dinheiro& diaria) const {
+    const long long diariaCentavos = diaria.getCentavos();
+    long long total = 0;
+    motorTarifario.cotar(&diariaCentavos, 1, reserva.getChegada(), reserva.getPartida(), &total);
+    if (Dinheiro::verificar(total) != nullptr) return false;
+    Dinheiro valor;
+    valor.setCentavos(total);
+    reserva.setValor(valor);
+    return true;
+}
+
+bool CntrMSReserva::criarReserva(const Reserva& reserva) {
+    // Compartilhada: impede só a exclusão do quarto no meio; o conflito de datas
+    // é protegido pela faixa do quarto
+    shared_lock<shared_mutex> bloqueio(trava);
+    lock_guard<mutex> bloqueioQuarto(travaDoQuarto(reserva.getQuarto()));
+    return incluirReserva(reserva) == SituacaoSolicitacao::CRIADA;
 }
 
 bool CntrMSReserva::deletarReserva(const Codigo& codigo) {
-    return containerReservas->remover(codigo);
+    // Compartilhada, como criarReserva: a remoção e a promoção dos pedidos em
+    // espera só envolvem o quarto da reserva, protegido pela faixa dele
+    shared_lock<shared_mutex> bloqueio(trava);
+    while (true) {
+        Reserva anterior;
+        anterior.setCodigo(codigo);
+        if (!containerReservas->pesquisar(&anterior)) return false;
+        lock_guard<mutex> bloqueioQuarto(travaDoQuarto(anterior.getQuarto()));
+
+        // Outra operação pode ter mudado a reserva de quarto antes da faixa
+        Reserva atual;
+        atual.setCodigo(codigo);
+        if (!containerReservas->pesquisar(&atual)) return false;
+        if (atual.getQuarto() != anterior.getQuarto()) continue;
+
+        if (!containerReservas->remover(codigo)) return false;
+        baseDesatualizada = true;
+        promoverEspera(atual.getQuarto(), atual.getChegada(), atual.getPartida());
+        return true;
+    }
 }
 
 bool CntrMSReserva::atualizarReserva(const Reserva& reserva) {
-    // Na atualização também deveríamos checar conflito, exceto com ela mesma.
-    // Simplificado para o trabalho:
-    return containerReservas->atualizar(reserva);
+    return alterarReserva(reserva, nullptr) == ResultadoAtualizacao::ATUALIZADO;
+}
+
+ResultadoAtualizacao CntrMSReserva::alterarReserva(const Reserva& reserva, const unsigned long long* versaoEsperada) {
+    // Compartilhada, como criarReserva: o conflito de datas é protegido pelas
+    // faixas do quarto atual e do novo
+    shared_lock<shared_mutex> bloqueio(trava);
+    if (reserva.getPartida() <= reserva.getChegada()) return ResultadoAtualizacao::RECUSADO;
+
+    while (true) {
+        Reserva anterior;
+        anterior.setCodigo(reserva.getCodigo());
+        if (!containerReservas->pesquisar(&anterior)) return ResultadoAtualizacao::NAO_ENCONTRADO;
+
+        // Faixas em ordem crescente de índice; a mesma faixa só uma vez
+        size_t faixaAnterior = static_cast<size_t>(anterior.getQuarto().getValor()) % FAIXAS_QUARTOS;
+        size_t faixaNova = static_cast<size_t>(reserva.getQuarto().getValor()) % FAIXAS_QUARTOS;
+        unique_lock<mutex> primeira(travasQuartos[min(faixaAnterior, faixaNova)]);
+        unique_lock<mutex> segunda;
+        if (faixaAnterior != faixaNova) segunda = unique_lock<mutex>(travasQuartos[max(faixaAnterior, faixaNova)]);
+
+        // Outra operação pode ter mudado a reserva de quarto antes das faixas
+        Reserva atual;
+        atual.setCodigo(reserva.getCodigo());
+        if (!containerReservas->pesquisar(&atual)) return ResultadoAtualizacao::NAO_ENCONTRADO;
+        if (atual.getQuarto() != anterior.getQuarto()) continue;
+
+        Quarto qTemp;
+        qTemp.setNumero(reserva.getQuarto());
+        if (!containerQuartos->pesquisar(&qTemp)) return ResultadoAtualizacao::RECUSADO;
+
+        // Conflito de datas com as outras reservas do quarto de destino
+        bool conflito = false;
+        containerReservas->percorrerPorQuarto(reserva.getQuarto(), [&](const Reserva& rExistente) {
+            conflito = conflito || (rExistente.getCodigo() != reserva.getCodigo() && verificarSobreposicao(
+                reserva.getChegada(), reserva.getPartida(),
+                rExistente.getChegada(), rExistente.getPartida()
+            ));
+        });
+        if (conflito) return ResultadoAtualizacao::RECUSADO;
+
+        Reserva precificada = reserva;
+        if (!precificar(precificada, qTemp.getDiaria())) return ResultadoAtualizacao::RECUSADO;
+        ResultadoAtualizacao resultado;
+        if (versaoEsperada) {
+            resultado = containerReservas->atualizar(precificada, *versaoEsperada);
+        } else {
+            resultado = containerReservas->atualizar(precificada) ? ResultadoAtualizacao::ATUALIZADO
+                                                                  : ResultadoAtualizacao::NAO_ENCONTRADO;
+        }
+        if (resultado == ResultadoAtualizacao::ATUALIZADO) {
+            baseDesatualizada = true;
+            promoverEspera(atual.getQuarto(), atual.getChegada(), atual.getPartida());
+        }
+        return resultado;
+    }
 }
 
 Reserva CntrMSReserva::lerReserva(const Codigo& codigo) {
@@ -252,3 +850,596 @@ Reserva CntrMSReserva::lerReserva(const Codigo& codigo) {
 list<Reserva> CntrMSReserva::listarReservas() {
     return containerReservas->listar();
 }
+
+bool CntrMSReserva::criarReserva(const Reserva& reserva, const string& chaveIdempotencia) {
+    if (chaveIdempotencia.empty()) return criarReserva(reserva);
+    return idempotencia.executar(chaveIdempotencia, [&] { return criarReserva(reserva); });
+}
+
+vector<Numero> CntrMSReserva::criarReservasGrupo(const vector<Reserva>& reservas) {
+    shared_lock<shared_mutex> bloqueio(trava);
+
+    // 1. Faixas dos quartos envolvidos, sempre em ordem crescente de índice
+    bool faixas[FAIXAS_QUARTOS] = {};
+    for (const auto& reserva : reservas) {
+        faixas[static_cast<size_t>(reserva.getQuarto().getValor()) % FAIXAS_QUARTOS] = true;
+    }
+    vector<unique_lock<mutex>> bloqueiosQuartos;
+    for (size_t i = 0; i < FAIXAS_QUARTOS; i++) {
+        if (faixas[i]) bloqueiosQuartos.emplace_back(travasQuartos[i]);
+    }
+
+    // 2. Mesmas regras de criarReserva, também entre as reservas do grupo
+    vector<bool> recusada(reservas.size(), false);
+    vector<Reserva> precificadas(reservas);
+    unordered_map<Codigo, size_t> codigos;
+    unordered_map<Numero, vector<size_t>> porQuarto;
+    codigos.reserve(reservas.size());
+    porQuarto.reserve(reservas.size());
+
+    for (size_t i = 0; i < reservas.size(); i++) {
+        const Reserva& reserva = reservas[i];
+        Reserva rTemp;
+        rTemp.setCodigo(reserva.getCodigo());
+        Quarto qTemp;
+        qTemp.setNumero(reserva.getQuarto());
+        if (!codigos.emplace(reserva.getCodigo(), i).second || containerReservas->pesquisar(&rTemp) ||
+            reserva.getPartida() <= reserva.getChegada() || !containerQuartos->pesquisar(&qTemp) ||
+            !precificar(precificadas[i], qTemp.getDiaria())) {
+            recusada[i] = true;
+            continue;
+        }
+
+        containerReservas->percorrerPorQuarto(reserva.getQuarto(), [&](const Reserva& rExistente) {
+            recusada[i] = recusada[i] || verificarSobreposicao(
+                reserva.getChegada(), reserva.getPartida(),
+                rExistente.getChegada(), rExistente.getPartida()
+            );
+        });
+        for (size_t j : porQuarto[reserva.getQuarto()]) {
+            if (verificarSobreposicao(reserva.getChegada(), reserva.getPartida(),
+                                      reservas[j].getChegada(), reservas[j].getPartida())) {
+                recusada[i] = true;
+            }
+        }
+        if (!recusada[i]) porQuarto[reserva.getQuarto()].push_back(i);
+    }
+
+    // 3. Inclusão de todas, ou de nenhuma se algum código tiver sido incluído
+    //    por outra faixa depois da verificação
+    vector<Numero> recusados;
+    auto recusar = [&](size_t i) {
+        const Numero& numero = reservas[i].getQuarto();
+        if (find(recusados.begin(), recusados.end(), numero) == recusados.end()) recusados.push_back(numero);
+    };
+    for (size_t i = 0; i < reservas.size(); i++) {
+        if (recusada[i]) recusar(i);
+    }
+    if (!recusados.empty() || reservas.empty()) return recusados;
+
+    Transacao transacao;
+    for (const auto& reserva : precificadas) transacao.incluir(*containerReservas, reserva);
+    if (!transacao.confirmar()) {
+        for (size_t i = 0; i < reservas.size(); i++) {
+            Reserva rTemp;
+            rTemp.setCodigo(reservas[i].getCodigo());
+            if (containerReservas->pesquisar(&rTemp)) recusar(i);
+        }
+        return recusados;
+    }
+    baseDesatualizada = true;
+    return recusados;
+}
+
+// --- LISTA DE ESPERA ---
+
+SituacaoSolicitacao CntrMSReserva::solicitarReserva(const Reserva& reserva, unsigned prioridade) {
+    shared_lock<shared_mutex> bloqueio(trava);
+    lock_guard<mutex> bloqueioQuarto(travaDoQuarto(reserva.getQuarto()));
+    SituacaoSolicitacao situacao = incluirReserva(reserva);
+    if (situacao != SituacaoSolicitacao::EM_ESPERA) return situacao;
+
+    lock_guard<mutex> bloqueioEspera(travaEspera);
+    return listaEspera.incluir(reserva, prioridade) ? situacao : SituacaoSolicitacao::RECUSADA;
+}
+
+bool CntrMSReserva::cancelarEspera(const Codigo& codigo) {
+    lock_guard<mutex> bloqueioEspera(travaEspera);
+    return listaEspera.remover(codigo);
+}
+
+list<Reserva> CntrMSReserva::listarEspera(const Numero& quarto) {
+    lock_guard<mutex> bloqueioEspera(travaEspera);
+    vector<Reserva> pedidos = listaEspera.listar(quarto);
+    return list<Reserva>(pedidos.begin(), pedidos.end());
+}
+
+// Chamada depois de liberar [inicio, fim) no quarto, com a trava exclusiva do
+// serviço ou com a compartilhada e a faixa do quarto: os pedidos promovidos
+// são todos desse quarto.
+// Sem mudança efetiva (ex.: atualização que manteve as datas) os candidatos
+// continuam em conflito e nada acontece.
+void CntrMSReserva::promoverEspera(const Numero& quarto, const Data& inicio, const Data& fim) {
+    lock_guard<mutex> bloqueioEspera(travaEspera);
+    for (const auto& pedido : listaEspera.candidatas(quarto, inicio, fim)) {
+        // Criado ou inválido agora (ex.: código usado por outra reserva): sai da lista
+        if (incluirReserva(pedido) != SituacaoSolicitacao::EM_ESPERA) listaEspera.remover(pedido.getCodigo());
+    }
+}
+
+// --- ATUALIZAÇÃO COM VERSÃO ESPERADA ---
+// Mesmas regras das atualizações simples; a versão é comparada pelo container,
+// sob a trava dele, no mesmo passo em que grava.
+
+ResultadoAtualizacao CntrMSReserva::atualizarHotel(const Hotel& hotel, unsigned long long versaoEsperada) {
+    unique_lock<shared_mutex> bloqueio(trava);
+    ResultadoAtualizacao resultado = containerHoteis->atualizar(hotel, versaoEsperada);
+    if (resultado == ResultadoAtualizacao::ATUALIZADO) {
+        cacheHoteis.invalidar(hotel.getCodigo());
+        baseDesatualizada = true;
+    }
+    return resultado;
+}
+
+ResultadoAtualizacao CntrMSReserva::atualizarQuarto(const Quarto& quarto, unsigned long long versaoEsperada) {
+    unique_lock<shared_mutex> bloqueio(trava);
+    Hotel hTemp;
+    hTemp.setCodigo(quarto.getHotel());
+    if (!containerHoteis->pesquisar(&hTemp)) return ResultadoAtualizacao::RECUSADO;
+
+    ResultadoAtualizacao resultado = containerQuartos->atualizar(quarto, versaoEsperada);
+    if (resultado == ResultadoAtualizacao::ATUALIZADO) {
+        cacheQuartos.invalidar(quarto.getNumero());
+        baseDesatualizada = true;
+    }
+    return resultado;
+}
+
+ResultadoAtualizacao CntrMSReserva::atualizarReserva(const Reserva& reserva, unsigned long long versaoEsperada) {
+    return alterarReserva(reserva, &versaoEsperada);
+}
+
+// --- TRANSAÇÕES ---
+
+thread_local const CntrMSReserva* CntrMSReserva::servicoEmCondicao = nullptr;
+
+// A condição de confirmar roda com a trava do serviço já obtida pela mesma
+// thread; pegá-la de novo poderia travar atrás de um escritor na fila
+shared_lock<shared_mutex> CntrMSReserva::travarLeitura() const {
+    if (servicoEmCondicao == this) return shared_lock<shared_mutex>();
+    return shared_lock<shared_mutex>(trava);
+}
+
+bool CntrMSReserva::avaliarCondicao(const function<bool()>& condicao) {
+    if (!condicao) return true;
+    servicoEmCondicao = this;
+    bool aceita;
+    try {
+        aceita = condicao();
+    } catch (...) {
+        servicoEmCondicao = nullptr;
+        throw;
+    }
+    servicoEmCondicao = nullptr;
+    return aceita;
+}
+
+// Estado atual das reservas que a transação atualiza ou remove; as inexistentes ficam de fora
+vector<Reserva> CntrMSReserva::lerAlteradas(const Transacao& transacao) const {
+    vector<Reserva> alteradas;
+    alteradas.reserve(transacao.getReservasAlteradas().size());
+    for (const auto& codigo : transacao.getReservasAlteradas()) {
+        Reserva reserva;
+        reserva.setCodigo(codigo);
+        if (containerReservas->pesquisar(&reserva)) alteradas.push_back(std::move(reserva));
+    }
+    return alteradas;
+}
+
+bool CntrMSReserva::confirmar(Transacao& transacao, const function<bool()>& condicao) {
+    // Senhas de gerentes derivadas fora das travas: o hash não segura as reservas
+    transacao.aguardarDerivacoes();
+
+    if (transacao.alteraHoteisOuQuartos()) {
+        unique_lock<shared_mutex> bloqueio(trava);
+        vector<Reserva> alteradas = lerAlteradas(transacao);
+        if (!avaliarCondicao(condicao)) {
+            transacao.cancelar();
+            return false;
+        }
+        if (!transacao.confirmar()) return false;
+        // A transação não informa quais hotéis e quartos alterou: as caches recomeçam vazias
+        cacheHoteis.limpar();
+        cacheQuartos.limpar();
+        baseDesatualizada = true;
+        for (const auto& r : alteradas) promoverEspera(r.getQuarto(), r.getChegada(), r.getPartida());
+        return true;
+    }
+
+    // Só reservas: faixas dos quartos, como em criarReservasGrupo
+    shared_lock<shared_mutex> bloqueio(trava);
+    while (true) {
+        vector<Reserva> alteradas = lerAlteradas(transacao);
+        bool faixas[FAIXAS_QUARTOS] = {};
+        for (const auto& numero : transacao.getQuartosReservados()) {
+            faixas[static_cast<size_t>(numero.getValor()) % FAIXAS_QUARTOS] = true;
+        }
+        for (const auto& r : alteradas) {
+            faixas[static_cast<size_t>(r.getQuarto().getValor()) % FAIXAS_QUARTOS] = true;
+        }
+        vector<unique_lock<mutex>> bloqueiosQuartos;
+        for (size_t i = 0; i < FAIXAS_QUARTOS; i++) {
+            if (faixas[i]) bloqueiosQuartos.emplace_back(travasQuartos[i]);
+        }
+
+        // Outra transação pode ter mudado uma reserva de quarto antes das faixas
+        vector<Reserva> atuais = lerAlteradas(transacao);
+        bool mesmosQuartos = atuais.size() == alteradas.size();
+        for (size_t i = 0; mesmosQuartos && i < atuais.size(); i++) {
+            mesmosQuartos = atuais[i].getQuarto() == alteradas[i].getQuarto();
+        }
+        if (!mesmosQuartos) continue;
+
+        if (!avaliarCondicao(condicao)) {
+            transacao.cancelar();
+            return false;
+        }
+        if (!transacao.confirmar()) return false;
+        baseDesatualizada = true;
+        for (const auto& r : atuais) promoverEspera(r.getQuarto(), r.getChegada(), r.getPartida());
+        return true;
+    }
+}
+
+// --- TARIFAÇÃO ---
+
+Dinheiro CntrMSReserva::cotarReserva(const Numero& quarto, const Data& chegada, const Data& partida) {
+    shared_ptr<const Quarto> q = obterQuarto(quarto);
+    shared_lock<shared_mutex> bloqueio = travarLeitura(); // Regras tarifárias estáveis durante o cálculo
+    return motorTarifario.calcular(q->getDiaria(), chegada, partida);
+}
+
+vector<Cotacao> CntrMSReserva::cotarQuartos(const Data& chegada, const Data& partida,
+                                           const Capacidade& capacidadeMinima) {
+    shared_lock<shared_mutex> bloqueio = travarLeitura();
+
+    // Separa as diárias em um vetor contíguo para a cotação em lote
+    vector<Numero> numeros;
+    vector<long long> diarias;
+
+    bool usouColunas = false;
+    containerQuartos->lerColunas([&](const ColunasQuarto* colunas) {
+        if (!colunas) return;
+        // Com o espelho colunar, o filtro lê só as capacidades, sem tocar nos objetos
+        const vector<unsigned short>& capacidades = colunas->getCapacidades();
+        for (size_t i = 0; i < capacidades.size(); i++) {
+            if (capacidades[i] < capacidadeMinima.getValor()) continue;
+            Numero numero;
+            numero.setValor(colunas->getNumeros()[i]);
+            numeros.push_back(numero);
+            diarias.push_back(colunas->getDiarias()[i]);
+        }
+        usouColunas = true;
+    });
+    if (!usouColunas) {
+        containerQuartos->percorrer([&](const Quarto& q) {
+            if (q.getCapacidade().getValor() < capacidadeMinima.getValor()) return;
+            numeros.push_back(q.getNumero());
+            diarias.push_back(q.getDiaria().getCentavos());
+        });
+    }
+
+    vector<long long> totais(diarias.size());
+    motorTarifario.cotar(diarias.data(), diarias.size(), chegada, partida, totais.data());
+
+    vector<Cotacao> cotacoes;
+    cotacoes.reserve(totais.size());
+    for (size_t i = 0; i < totais.size(); i++) {
+        Cotacao cotacao;
+        cotacao.quarto = numeros[i];
+        cotacao.erro = Dinheiro::verificar(totais[i]);
+        if (!cotacao.erro) cotacao.valor.setCentavos(totais[i]);
+        cotacoes.push_back(cotacao);
+    }
+    return cotacoes;
+}
+
+// --- ANÁLISES ---
+
+RelatorioOcupacao CntrMSReserva::gerarRelatorio(const Data& inicio, const Data& fim) {
+    lock_guard<mutex> bloqueioAnalises(travaAnalises);
+
+    // A cópia colunar só é refeita quando algo mudou; consultas seguidas reaproveitam a mesma base
+    {
+        // Sem alterações no meio da carga, exceto novas reservas: a marca é limpa
+        // antes de carregar, então uma reserva que a carga perder a deixa marcada
+        shared_lock<shared_mutex> bloqueio(trava);
+        if (baseDesatualizada.exchange(false)) {
+            baseAnalitica.carregar(*containerHoteis, *containerQuartos, *containerReservas);
+        }
+    }
+    return baseAnalitica.calcular(inicio, fim, escalonador);
+}
+
+// ====================================================================
+// 4. MOTOR TARIFÁRIO
+// ====================================================================
+
+void MotorTarifario::setRegras(const RegrasTarifarias& novasRegras) {
+    // Em long long: ajustes perto de INT_MAX dariam a volta já na soma em int
+    for (int mes = 1; mes <= 12; mes++) {
+        if (novasRegras.ajusteSazonal[mes] < -10000)
+            throw invalid_argument("Ajuste sazonal nao pode ser inferior a -100%.");
+        if (10000LL + novasRegras.ajusteSazonal[mes] + novasRegras.acrescimoFimDeSemana > FATOR_NOITE_MAXIMO)
+            throw invalid_argument("Ajuste sazonal e acrescimo de fim de semana excedem o fator maximo por noite.");
+    }
+    for (const auto& faixa : novasRegras.descontosPermanencia) {
+        if (faixa.second > 10000)
+            throw invalid_argument("Desconto de permanencia nao pode exceder 100%.");
+    }
+    this->regras = novasRegras;
+}
+
+int MotorTarifario::contarNoites(const Data& chegada, const Data& partida) {
+    int noites = chegada.noitesAte(partida);
+    if (noites < 1) throw invalid_argument("Periodo deve conter ao menos uma noite.");
+    return noites;
+}
+
+long long MotorTarifario::fatorEstadia(const Data& chegada, int noites) const {
+    long long fator = 0;
+    int serial = chegada.getSerial();
+
+    // Percorre o período por segmentos de mês (no máximo um por mês, não por noite)
+    while (noites > 0) {
+        unsigned short dia = 0, mes = 0, ano = 0;
+        Calendario::deSerial(serial, dia, mes, ano);
+        int noitesNoMes = min(noites, Calendario::diasNoMes(mes, ano) - dia + 1);
+
+        int fimDeSemana = Calendario::contarDiaDaSemana(serial, noitesNoMes, Calendario::SEXTA)
+                        + Calendario::contarDiaDaSemana(serial, noitesNoMes, Calendario::SABADO);
+
+        fator += static_cast<long long>(noitesNoMes) * (10000 + regras.ajusteSazonal[mes])
+               + static_cast<long long>(fimDeSemana) * regras.acrescimoFimDeSemana;
+
+        serial += noitesNoMes;
+        noites -= noitesNoMes;
+    }
+    return fator;
+}
+
+unsigned int MotorTarifario::descontoPermanencia(int noites) const {
+    unsigned int desconto = 0;
+    int melhorMinimo = 0;
+    for (const auto& faixa : regras.descontosPermanencia) {
+        if (noites >= faixa.first && faixa.first >= melhorMinimo) {
+            melhorMinimo = faixa.first;
+            desconto = faixa.second;
+        }
+    }
+    return desconto;
+}
+
+Dinheiro MotorTarifario::calcular(const Dinheiro& diaria, const Data& chegada, const Data& partida) const {
+    long long diariaCentavos = diaria.getCentavos();
+    long long total = 0;
+    cotar(&diariaCentavos, 1, chegada, partida, &total);
+
+    Dinheiro valor;
+    valor.setCentavos(total);
+    return valor;
+}
+
+void MotorTarifario::cotar(const long long* diarias, size_t quantidade,
+                           const Data& chegada, const Data& partida, long long* totais) const {
+    int noites = contarNoites(chegada, partida);
+    const long long fator = fatorEstadia(chegada, noites);
+    const long long fatorPermanencia = 10000 - descontoPermanencia(noites);
+
+    // Laço sem desvios: duas multiplicações com arredondamento meio-para-cima por quarto
+    for (size_t i = 0; i < quantidade; i++) {
+        long long bruto = (diarias[i] * fator + 5000) / 10000;
+        totais[i] = (bruto * fatorPermanencia + 5000) / 10000;
+    }
+}
+
+// ====================================================================
+// 5. SERVIÇOS ASSÍNCRONOS
+// ====================================================================
+
+// As tarefas capturam cópias dos argumentos: o chamador pode descartá-los logo após a chamada
+
+// --- PESSOAL ---
+
+future<bool> CntrMSPessoaAssincrono::criarGerente(const Gerente& gerente) {
+    return escalonador->submeter([this, gerente] { return servico->criarGerente(gerente); });
+}
+
+future<bool> CntrMSPessoaAssincrono::deletarGerente(const EMAIL& email) {
+    return escalonador->submeter([this, email] { return servico->deletarGerente(email); });
+}
+
+future<bool> CntrMSPessoaAssincrono::atualizarGerente(const Gerente& gerente) {
+    return escalonador->submeter([this, gerente] { return servico->atualizarGerente(gerente); });
+}
+
+future<Gerente> CntrMSPessoaAssincrono::lerGerente(const EMAIL& email) {
+    return escalonador->submeter([this, email] { return servico->lerGerente(email); });
+}
+
+future<list<Gerente>> CntrMSPessoaAssincrono::listarGerentes() {
+    return escalonador->submeter([this] { return servico->listarGerentes(); }, Prioridade::BAIXA);
+}
+
+future<bool> CntrMSPessoaAssincrono::criarHospede(const Hospede& hospede) {
+    return escalonador->submeter([this, hospede] { return servico->criarHospede(hospede); });
+}
+
+future<bool> CntrMSPessoaAssincrono::deletarHospede(const EMAIL& email) {
+    return escalonador->submeter([this, email] { return servico->deletarHospede(email); });
+}
+
+future<bool> CntrMSPessoaAssincrono::atualizarHospede(const Hospede& hospede) {
+    return escalonador->submeter([this, hospede] { return servico->atualizarHospede(hospede); });
+}
+
+future<Hospede> CntrMSPessoaAssincrono::lerHospede(const EMAIL& email) {
+    return escalonador->submeter([this, email] { return servico->lerHospede(email); });
+}
+
+future<list<Hospede>> CntrMSPessoaAssincrono::listarHospedes() {
+    return escalonador->submeter([this] { return servico->listarHospedes(); }, Prioridade::BAIXA);
+}
+
+future<vector<Hospede>> CntrMSPessoaAssincrono::buscarHospedes(const string& nome, unsigned distanciaMaxima,
+                                                               size_t limite) {
+    return escalonador->submeter([this, nome, distanciaMaxima, limite] {
+        return servico->buscarHospedes(nome, distanciaMaxima, limite);
+    });
+}
+
+future<ResultadoAtualizacao> CntrMSPessoaAssincrono::atualizarHospede(const Hospede& hospede,
+                                                                      unsigned long long versaoEsperada) {
+    return escalonador->submeter([this, hospede, versaoEsperada] {
+        return servico->atualizarHospede(hospede, versaoEsperada);
+    });
+}
+
+// --- RESERVAS E INFRA ---
+
+future<bool> CntrMSReservaAssincrono::criarHotel(const Hotel& hotel) {
+    return escalonador->submeter([this, hotel] { return servico->criarHotel(hotel); });
+}
+
+future<bool> CntrMSReservaAssincrono::deletarHotel(const Codigo& codigo) {
+    return escalonador->submeter([this, codigo] { return servico->deletarHotel(codigo); });
+}
+
+future<bool> CntrMSReservaAssincrono::atualizarHotel(const Hotel& hotel) {
+    return escalonador->submeter([this, hotel] { return servico->atualizarHotel(hotel); });
+}
+
+future<Hotel> CntrMSReservaAssincrono::lerHotel(const Codigo& codigo) {
+    return escalonador->submeter([this, codigo] { return servico->lerHotel(codigo); });
+}
+
+future<list<Hotel>> CntrMSReservaAssincrono::listarHoteis() {
+    return escalonador->submeter([this] { return servico->listarHoteis(); }, Prioridade::BAIXA);
+}
+
+future<vector<Hotel>> CntrMSReservaAssincrono::buscarHoteis(const string& prefixo, size_t limite) {
+    return escalonador->submeter([this, prefixo, limite] { return servico->buscarHoteis(prefixo, limite); });
+}
+
+future<bool> CntrMSReservaAssincrono::criarQuarto(const Quarto& quarto) {
+    return escalonador->submeter([this, quarto] { return servico->criarQuarto(quarto); });
+}
+
+future<bool> CntrMSReservaAssincrono::deletarQuarto(const Numero& numero) {
+    return escalonador->submeter([this, numero] { return servico->deletarQuarto(numero); });
+}
+
+future<bool> CntrMSReservaAssincrono::atualizarQuarto(const Quarto& quarto) {
+    return escalonador->submeter([this, quarto] { return servico->atualizarQuarto(quarto); });
+}
+
+future<Quarto> CntrMSReservaAssincrono::lerQuarto(const Numero& numero) {
+    return escalonador->submeter([this, numero] { return servico->lerQuarto(numero); });
+}
+
+future<list<Quarto>> CntrMSReservaAssincrono::listarQuartos() {
+    return escalonador->submeter([this] { return servico->listarQuartos(); }, Prioridade::BAIXA);
+}
+
+future<bool> CntrMSReservaAssincrono::criarReserva(const Reserva& reserva) {
+    return escalonador->submeter([this, reserva] { return servico->criarReserva(reserva); });
+}
+
+future<bool> CntrMSReservaAssincrono::deletarReserva(const Codigo& codigo) {
+    return escalonador->submeter([this, codigo] { return servico->deletarReserva(codigo); });
+}
+
+future<bool> CntrMSReservaAssincrono::atualizarReserva(const Reserva& reserva) {
+    return escalonador->submeter([this, reserva] { return servico->atualizarReserva(reserva); });
+}
+
+future<Reserva> CntrMSReservaAssincrono::lerReserva(const Codigo& codigo) {
+    return escalonador->submeter([this, codigo] { return servico->lerReserva(codigo); });
+}
+
+future<list<Reserva>> CntrMSReservaAssincrono::listarReservas() {
+    return escalonador->submeter([this] { return servico->listarReservas(); }, Prioridade::BAIXA);
+}
+
+future<bool> CntrMSReservaAssincrono::criarReserva(const Reserva& reserva, const string& chaveIdempotencia) {
+    return escalonador->submeter([this, reserva, chaveIdempotencia] {
+        return servico->criarReserva(reserva, chaveIdempotencia);
+    });
+}
+
+future<vector<Numero>> CntrMSReservaAssincrono::criarReservasGrupo(const vector<Reserva>& reservas) {
+    return escalonador->submeter([this, reservas] { return servico->criarReservasGrupo(reservas); });
+}
+
+future<SituacaoSolicitacao> CntrMSReservaAssincrono::solicitarReserva(const Reserva& reserva, unsigned prioridade) {
+    return escalonador->submeter([this, reserva, prioridade] {
+        return servico->solicitarReserva(reserva, prioridade);
+    });
+}
+
+future<bool> CntrMSReservaAssincrono::cancelarEspera(const Codigo& codigo) {
+    return escalonador->submeter([this, codigo] { return servico->cancelarEspera(codigo); });
+}
+
+future<list<Reserva>> CntrMSReservaAssincrono::listarEspera(const Numero& quarto) {
+    return escalonador->submeter([this, quarto] { return servico->listarEspera(quarto); });
+}
+
+future<shared_ptr<const Hotel>> CntrMSReservaAssincrono::obterHotel(const Codigo& codigo) {
+    return escalonador->submeter([this, codigo] { return servico->obterHotel(codigo); });
+}
+
+future<shared_ptr<const Quarto>> CntrMSReservaAssincrono::obterQuarto(const Numero& numero) {
+    return escalonador->submeter([this, numero] { return servico->obterQuarto(numero); });
+}
+
+future<ResultadoAtualizacao> CntrMSReservaAssincrono::atualizarHotel(const Hotel& hotel,
+                                                                     unsigned long long versaoEsperada) {
+    return escalonador->submeter([this, hotel, versaoEsperada] {
+        return servico->atualizarHotel(hotel, versaoEsperada);
+    });
+}
+
+future<ResultadoAtualizacao> CntrMSReservaAssincrono::atualizarQuarto(const Quarto& quarto,
+                                                                      unsigned long long versaoEsperada) {
+    return escalonador->submeter([this, quarto, versaoEsperada] {
+        return servico->atualizarQuarto(quarto, versaoEsperada);
+    });
+}
+
+future<ResultadoAtualizacao> CntrMSReservaAssincrono::atualizarReserva(const Reserva& reserva,
+                                                                       unsigned long long versaoEsperada) {
+    return escalonador->submeter([this, reserva, versaoEsperada] {
+        return servico->atualizarReserva(reserva, versaoEsperada);
+    });
+}
+
+future<Dinheiro> CntrMSReservaAssincrono::cotarReserva(const Numero& quarto, const Data& chegada,
+                                                      const Data& partida) {
+    return escalonador->submeter([this, quarto, chegada, partida] {
+        return servico->cotarReserva(quarto, chegada, partida);
+    });
+}
+
+future<vector<Cotacao>> CntrMSReservaAssincrono::cotarQuartos(const Data& chegada, const Data& partida,
+                                                             const Capacidade& capacidadeMinima) {
+    return escalonador->submeter([this, chegada, partida, capacidadeMinima] {
+        return servico->cotarQuartos(chegada, partida, capacidadeMinima);
+    }, Prioridade::BAIXA);
+}
+
+future<RelatorioOcupacao> CntrMSReservaAssincrono::gerarRelatorio(const Data& inicio, const Data& fim) {
+    return escalonador->submeter([this, inicio, fim] {
+        return servico->gerarRelatorio(inicio, fim);
+    }, Prioridade::BAIXA);
+}
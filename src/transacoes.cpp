@@ -0,0 +1,245 @@
+#include "transacoes.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+using namespace std;
+
+// ====================================================================
+// IMPLEMENTAÇÃO: TRANSAÇÃO
+// ====================================================================
+
+namespace {
+
+// Ordem global das travas, por tipo de container
+enum OrdemTrava { ORDEM_GERENTE, ORDEM_HOSPEDE, ORDEM_HOTEL, ORDEM_QUARTO, ORDEM_RESERVA };
+
+} // namespace
+
+// --- REGISTRO GENÉRICO ---
+
+template <typename Container, typename Entidade, typename Chave>
+void Transacao::registrarInclusao(int ordem, Container& container, const Entidade& entidade, const Chave& chave) {
+    Container* alvo = &container;
+    operacoes.push_back({ordem, alvo, &alvo->trava, [alvo, entidade, chave](Desfazer& desfazer) {
+        if (!alvo->incluirSemTrava(entidade)) return false;
+        desfazer.push_back([alvo, chave] { alvo->removerSemTrava(chave, nullptr); });
+        return true;
+    }});
+}
+
+template <typename Entidade, typename Container, typename Chave>
+void Transacao::registrarRemocao(int ordem, Container& container, const Chave& chave) {
+    Container* alvo = &container;
+    operacoes.push_back({ordem, alvo, &alvo->trava, [alvo, chave](Desfazer& desfazer) {
+        Entidade removido;
+        if (!alvo->removerSemTrava(chave, &removido)) return false;
+        desfazer.push_back([alvo, removido] { alvo->restaurarSemTrava(removido); });
+        return true;
+    }});
+}
+
+template <typename Container, typename Entidade>
+void Transacao::registrarAtualizacao(int ordem, Container& container, const Entidade& entidade,
+                                     bool verificarVersao, unsigned long long versaoEsperada) {
+    Container* alvo = &container;
+    operacoes.push_back({ordem, alvo, &alvo->trava,
+                         [alvo, entidade, verificarVersao, versaoEsperada](Desfazer& desfazer) {
+        Entidade anterior;
+        ResultadoAtualizacao resultado =
+            alvo->atualizarSemTrava(entidade, &anterior, verificarVersao ? &versaoEsperada : nullptr);
+        if (resultado != ResultadoAtualizacao::ATUALIZADO) return false;
+        desfazer.push_back([alvo, anterior] { alvo->restaurarSemTrava(anterior); });
+        return true;
+    }});
+}
+
+// --- GERENTE ---
+
+void Transacao::incluir(ContainerGerente& container, const Gerente& gerente) {
+    ContainerGerente* alvo = &container;
+    shared_future<Credencial> credencial = alvo->derivar(gerente.getSenha().getValor()).share();
+    derivacoes.push_back(credencial);
+    operacoes.push_back({ORDEM_GERENTE, alvo, &alvo->trava, [alvo, gerente, credencial](Desfazer& desfazer) {
+        if (!alvo->incluirSemTrava(gerente, credencial.get())) return false;
+        EMAIL email = gerente.getEmail();
+        desfazer.push_back([alvo, email] { alvo->removerSemTrava(email, nullptr, nullptr); });
+        return true;
+    }});
+}
+
+void Transacao::remover(ContainerGerente& container, const EMAIL& email) {
+    ContainerGerente* alvo = &container;
+    operacoes.push_back({ORDEM_GERENTE, alvo, &alvo->trava, [alvo, email](Desfazer& desfazer) {
+        Gerente removido;
+        Credencial credencial;
+        if (!alvo->removerSemTrava(email, &removido, &credencial)) return false;
+        desfazer.push_back([alvo, removido, credencial] { alvo->incluirSemTrava(removido, credencial); });
+        return true;
+    }});
+}
+
+void Transacao::atualizar(ContainerGerente& container, const Gerente& gerente) {
+    ContainerGerente* alvo = &container;
+    const bool novaSenha = !gerente.getSenha().getValor().empty();
+    shared_future<Credencial> credencial;
+    if (novaSenha) {
+        credencial = alvo->derivar(gerente.getSenha().getValor()).share();
+        derivacoes.push_back(credencial);
+    }
+
+    operacoes.push_back({ORDEM_GERENTE, alvo, &alvo->trava,
+                         [alvo, gerente, novaSenha, credencial](Desfazer& desfazer) {
+        Gerente anterior;
+        Credencial credencialAnterior;
+        if (!alvo->atualizarSemTrava(gerente, novaSenha ? &credencial.get() : nullptr, &anterior, &credencialAnterior)) {
+            return false;
+        }
+        desfazer.push_back([alvo, anterior, credencialAnterior] {
+            alvo->atualizarSemTrava(anterior, &credencialAnterior, nullptr, nullptr);
+        });
+        return true;
+    }});
+}
+
+// --- HÓSPEDE ---
+
+void Transacao::incluir(ContainerHospede& container, const Hospede& hospede) {
+    registrarInclusao(ORDEM_HOSPEDE, container, hospede, hospede.getEmail());
+}
+
+void Transacao::remover(ContainerHospede& container, const EMAIL& email) {
+    registrarRemocao<Hospede>(ORDEM_HOSPEDE, container, email);
+}
+
+void Transacao::atualizar(ContainerHospede& container, const Hospede& hospede) {
+    registrarAtualizacao(ORDEM_HOSPEDE, container, hospede, false, 0);
+}
+
+void Transacao::atualizar(ContainerHospede& container, const Hospede& hospede, unsigned long long versaoEsperada) {
+    registrarAtualizacao(ORDEM_HOSPEDE, container, hospede, true, versaoEsperada);
+}
+
+// --- HOTEL ---
+
+void Transacao::incluir(ContainerHotel& container, const Hotel& hotel) {
+    registrarInclusao(ORDEM_HOTEL, container, hotel, hotel.getCodigo());
+}
+
+void Transacao::remover(ContainerHotel& container, const Codigo& codigo) {
+    registrarRemocao<Hotel>(ORDEM_HOTEL, container, codigo);
+}
+
+void Transacao::atualizar(ContainerHotel& container, const Hotel& hotel) {
+    registrarAtualizacao(ORDEM_HOTEL, container, hotel, false, 0);
+}
+
+void Transacao::atualizar(ContainerHotel& container, const Hotel& hotel, unsigned long long versaoEsperada) {
+    registrarAtualizacao(ORDEM_HOTEL, container, hotel, true, versaoEsperada);
+}
+
+// --- QUARTO ---
+
+void Transacao::incluir(ContainerQuarto& container, const Quarto& quarto) {
+    registrarInclusao(ORDEM_QUARTO, container, quarto, quarto.getNumero());
+}
+
+void Transacao::remover(ContainerQuarto& container, const Numero& numero) {
+    registrarRemocao<Quarto>(ORDEM_QUARTO, container, numero);
+}
+
+void Transacao::atualizar(ContainerQuarto& container, const Quarto& quarto) {
+    registrarAtualizacao(ORDEM_QUARTO, container, quarto, false, 0);
+}
+
+void Transacao::atualizar(ContainerQuarto& container, const Quarto& quarto, unsigned long long versaoEsperada) {
+    registrarAtualizacao(ORDEM_QUARTO, container, quarto, true, versaoEsperada);
+}
+
+// --- RESERVA ---
+
+void Transacao::incluir(ContainerReserva& container, const Reserva& reserva) {
+    quartosReservados.push_back(reserva.getQuarto());
+    registrarInclusao(ORDEM_RESERVA, container, reserva, reserva.getCodigo());
+}
+
+void Transacao::remover(ContainerReserva& container, const Codigo& codigo) {
+    reservasAlteradas.push_back(codigo);
+    registrarRemocao<Reserva>(ORDEM_RESERVA, container, codigo);
+}
+
+void Transacao::atualizar(ContainerReserva& container, const Reserva& reserva) {
+    quartosReservados.push_back(reserva.getQuarto());
+    reservasAlteradas.push_back(reserva.getCodigo());
+    registrarAtualizacao(ORDEM_RESERVA, container, reserva, false, 0);
+}
+
+void Transacao::atualizar(ContainerReserva& container, const Reserva& reserva, unsigned long long versaoEsperada) {
+    quartosReservados.push_back(reserva.getQuarto());
+    reservasAlteradas.push_back(reserva.getCodigo());
+    registrarAtualizacao(ORDEM_RESERVA, container, reserva, true, versaoEsperada);
+}
+
+// --- CONFIRMAÇÃO ---
+
+bool Transacao::alteraHoteisOuQuartos() const {
+    return any_of(operacoes.begin(), operacoes.end(), [](const Operacao& operacao) {
+        return operacao.ordem == ORDEM_HOTEL || operacao.ordem == ORDEM_QUARTO;
+    });
+}
+
+void Transacao::cancelar() {
+    operacoes.clear();
+    derivacoes.clear();
+    quartosReservados.clear();
+    reservasAlteradas.clear();
+}
+
+void Transacao::aguardarDerivacoes() {
+    try {
+        for (const auto& derivacao : derivacoes) derivacao.get(); // get repassa a falha do verificador
+    } catch (...) {
+        cancelar();
+        throw;
+    }
+}
+
+bool Transacao::confirmar() {
+    // 1. Senhas derivadas antes das travas
+    aguardarDerivacoes();
+    vector<Operacao> registradas = std::move(operacoes);
+    cancelar();
+
+    // 2. Travas distintas, na ordem global (tipo do container, endereço)
+    vector<pair<pair<int, uintptr_t>, shared_mutex*>> travas;
+    travas.reserve(registradas.size());
+    for (const auto& operacao : registradas) {
+        travas.push_back({{operacao.ordem, reinterpret_cast<uintptr_t>(operacao.container)}, operacao.trava});
+    }
+    sort(travas.begin(), travas.end());
+    travas.erase(unique(travas.begin(), travas.end()), travas.end());
+
+    vector<unique_lock<shared_mutex>> bloqueios;
+    bloqueios.reserve(travas.size());
+    for (const auto& trava : travas) bloqueios.emplace_back(*trava.second);
+
+    // 3. Aplicação, com desfazer na ordem inversa à primeira falha
+    Desfazer desfazer;
+    desfazer.reserve(registradas.size());
+    auto reverter = [&desfazer] {
+        for (auto it = desfazer.rbegin(); it != desfazer.rend(); ++it) (*it)();
+    };
+    try {
+        for (auto& operacao : registradas) {
+            if (!operacao.aplicar(desfazer)) {
+                reverter();
+                return false;
+            }
+        }
+    } catch (...) {
+        reverter();
+        throw;
+    }
+    return true;
+}